@@ -2,8 +2,10 @@ class_name ModelDownloader
 extends Node
 ## Downloads GGUF models from HuggingFace during development.
 ##
-## Handles large file downloads with progress tracking.
-## Models are saved to user://models/ directory.
+## Uses the native ParallelDownloader: several connections fetch byte ranges
+## in parallel, interrupted downloads resume where they stopped and the
+## SHA-256 is verified without re-reading the file.
+## Models are saved to res://models/ directory.
 
 ## Emitted when download starts
 signal download_started(model_id: String)
@@ -23,7 +25,10 @@ signal download_cancelled(model_id: String)
 const DOWNLOAD_DIR = "res://models/"
 const USER_AGENT = "OhMyDialogSystem/1.0 (Godot GDExtension)"
 
-var _http_request: HTTPRequest
+## Number of parallel connections per download
+@export_range(1, 16) var connections: int = 4
+
+var _downloader: ParallelDownloader
 var _current_config: ModelConfig
 var _target_path: String
 var _is_downloading: bool = false
@@ -40,7 +45,8 @@ func _ensure_download_directory() -> void:
 		DirAccess.make_dir_recursive_absolute(DOWNLOAD_DIR)
 
 
-## Starts downloading a model from its configured URL
+## Starts downloading a model from its configured URL.
+## A previously interrupted download of the same model is resumed.
 func download_model(config: ModelConfig) -> Error:
 	if _is_downloading:
 		push_error("ModelDownloader: Already downloading a model")
@@ -59,26 +65,22 @@ func download_model(config: ModelConfig) -> Error:
 	_downloaded_bytes = 0
 	_total_bytes = int(config.size_mb * 1024 * 1024)  # Estimate from config
 
-	# Create HTTPRequest if needed
-	if _http_request == null:
-		_http_request = HTTPRequest.new()
-		_http_request.use_threads = true
-		_http_request.download_file = _target_path
-		add_child(_http_request)
-		_http_request.request_completed.connect(_on_request_completed)
-
-	# Configure for large downloads
-	_http_request.download_file = _target_path
-	_http_request.timeout = 0  # No timeout for large files
+	# Create ParallelDownloader if needed
+	if _downloader == null:
+		_downloader = ParallelDownloader.new()
+		_downloader.download_completed.connect(_on_download_completed)
+		_downloader.download_failed.connect(_on_download_failed)
 
-	# Start request
-	var headers = [
-		"User-Agent: %s" % USER_AGENT
-	]
+	var options = {
+		"connections": connections,
+		"headers": PackedStringArray(["User-Agent: %s" % USER_AGENT])
+	}
+	if not config.sha256.is_empty():
+		options["sha256"] = config.sha256
 
-	var err = _http_request.request(config.download_url, headers)
+	var err = _downloader.start(config.download_url, _target_path, options)
 	if err != OK:
-		push_error("ModelDownloader: Failed to start request: %s" % error_string(err))
+		push_error("ModelDownloader: Failed to start download: %s" % error_string(err))
 		return err
 
 	_is_downloading = true
@@ -88,15 +90,18 @@ func download_model(config: ModelConfig) -> Error:
 	return OK
 
 
-## Cancels the current download
-func cancel_download() -> void:
+## Cancels the current download.
+## The partial file is kept so the next download_model() call resumes it,
+## unless discard_partial is true.
+func cancel_download(discard_partial: bool = false) -> void:
 	if not _is_downloading:
 		return
 
-	if _http_request != null:
-		_http_request.cancel_request()
+	if _downloader != null:
+		_downloader.cancel()
 
-	_cleanup_partial_download()
+	if discard_partial:
+		_cleanup_partial_download()
 
 	var model_id = _current_config.id if _current_config else ""
 	_is_downloading = false
@@ -135,15 +140,15 @@ func get_total_bytes() -> int:
 
 
 func _process(_delta: float) -> void:
-	if not _is_downloading or _http_request == null:
+	if not _is_downloading or _downloader == null:
 		return
 
-	# Update progress from HTTPRequest
-	var body_size = _http_request.get_body_size()
-	var downloaded = _http_request.get_downloaded_bytes()
+	# Update progress from ParallelDownloader
+	var total = _downloader.get_total_bytes()
+	var downloaded = _downloader.get_downloaded_bytes()
 
-	if body_size > 0:
-		_total_bytes = body_size
+	if total > 0:
+		_total_bytes = total
 
 	if downloaded != _downloaded_bytes:
 		_downloaded_bytes = downloaded
@@ -154,45 +159,31 @@ func _process(_delta: float) -> void:
 		)
 
 
-func _on_request_completed(result: int, response_code: int, _headers: PackedStringArray, _body: PackedByteArray) -> void:
+func _on_download_completed(path: String, sha256: String) -> void:
+	# Deferred signal: cancel_download() may already have reported this download
+	if not _is_downloading:
+		return
+
 	var model_id = _current_config.id if _current_config else ""
 	var model_name = _current_config.display_name if _current_config else "unknown"
 
 	_is_downloading = false
 
-	if result != HTTPRequest.RESULT_SUCCESS:
-		var error_msg = _get_result_error_message(result)
-		push_error("ModelDownloader: Download failed - %s" % error_msg)
-		_cleanup_partial_download()
-		download_failed.emit(model_id, error_msg)
-		_current_config = null
-		return
+	print("ModelDownloader: Successfully downloaded %s to %s (sha256 %s)" % [model_name, path, sha256])
+	download_completed.emit(model_id, path)
+	_current_config = null
 
-	if response_code != 200:
-		var error_msg = "HTTP error %d" % response_code
-		if response_code == 404:
-			error_msg = "Model file not found (404). The URL may have changed."
-		elif response_code == 403:
-			error_msg = "Access denied (403). The model may require authentication."
-		elif response_code >= 500:
-			error_msg = "Server error (%d). Please try again later." % response_code
 
-		push_error("ModelDownloader: %s" % error_msg)
-		_cleanup_partial_download()
-		download_failed.emit(model_id, error_msg)
-		_current_config = null
+func _on_download_failed(_error: int, message: String) -> void:
+	if not _is_downloading:
 		return
 
-	# Verify file was saved
-	if not FileAccess.file_exists(_target_path):
-		var error_msg = "File was not saved to disk"
-		push_error("ModelDownloader: %s" % error_msg)
-		download_failed.emit(model_id, error_msg)
-		_current_config = null
-		return
+	var model_id = _current_config.id if _current_config else ""
+
+	_is_downloading = false
 
-	print("ModelDownloader: Successfully downloaded %s to %s" % [model_name, _target_path])
-	download_completed.emit(model_id, _target_path)
+	push_error("ModelDownloader: Download failed - %s" % message)
+	download_failed.emit(model_id, message)
 	_current_config = null
 
 
@@ -200,39 +191,9 @@ func _cleanup_partial_download() -> void:
 	if _target_path.is_empty():
 		return
 
-	if FileAccess.file_exists(_target_path):
-		var err = DirAccess.remove_absolute(_target_path)
-		if err != OK:
-			push_warning("ModelDownloader: Could not remove partial download: %s" % _target_path)
-
-
-func _get_result_error_message(result: int) -> String:
-	match result:
-		HTTPRequest.RESULT_CHUNKED_BODY_SIZE_MISMATCH:
-			return "Chunked body size mismatch"
-		HTTPRequest.RESULT_CANT_CONNECT:
-			return "Cannot connect to server"
-		HTTPRequest.RESULT_CANT_RESOLVE:
-			return "Cannot resolve hostname"
-		HTTPRequest.RESULT_CONNECTION_ERROR:
-			return "Connection error"
-		HTTPRequest.RESULT_TLS_HANDSHAKE_ERROR:
-			return "TLS handshake failed"
-		HTTPRequest.RESULT_NO_RESPONSE:
-			return "No response from server"
-		HTTPRequest.RESULT_BODY_SIZE_LIMIT_EXCEEDED:
-			return "Body size limit exceeded"
-		HTTPRequest.RESULT_BODY_DECOMPRESS_FAILED:
-			return "Failed to decompress body"
-		HTTPRequest.RESULT_REQUEST_FAILED:
-			return "Request failed"
-		HTTPRequest.RESULT_DOWNLOAD_FILE_CANT_OPEN:
-			return "Cannot open download file"
-		HTTPRequest.RESULT_DOWNLOAD_FILE_WRITE_ERROR:
-			return "Error writing to download file"
-		HTTPRequest.RESULT_REDIRECT_LIMIT_REACHED:
-			return "Too many redirects"
-		HTTPRequest.RESULT_TIMEOUT:
-			return "Request timed out"
-		_:
-			return "Unknown error (%d)" % result
+	# Unfinished data lives in .part, the target only appears once verified
+	for path in [_target_path + ".part", _target_path + ".progress"]:
+		if FileAccess.file_exists(path):
+			var err = DirAccess.remove_absolute(ProjectSettings.globalize_path(path))
+			if err != OK:
+				push_warning("ModelDownloader: Could not remove partial download: %s" % path)
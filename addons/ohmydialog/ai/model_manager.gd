@@ -51,6 +51,12 @@ func _ready() -> void:
 	_load_registry()
 
 
+func _process(delta: float) -> void:
+	# Frame times drive the adaptive inference thread count
+	if llama != null and llama.adaptive_threads:
+		llama.report_frame_time(delta * 1000.0)
+
+
 func _load_registry() -> void:
 	var registry_path = "user://ohmydialog_registry.tres"
 
@@ -24,6 +24,9 @@ extends Resource
 ## Estimated file size in MB (for download progress)
 @export var size_mb: float = 0.0
 
+## Expected SHA-256 of the GGUF file as hex (empty = not verified)
+@export var sha256: String = ""
+
 ## Whether this is a custom/user-added model (shows warning)
 @export var is_custom: bool = false
 
@@ -61,17 +64,74 @@ extends Resource
 ## Batch size for prompt processing
 @export var n_batch: int = 512
 
+@export_group("Memory Settings")
+
+## KV cache type for keys (q8_0/q4_0 trade a little quality for much less memory)
+@export_enum("f16", "q8_0", "q4_0") var cache_type_k: String = "f16"
+
+## KV cache type for values (quantized types require flash attention)
+@export_enum("f16", "q8_0", "q4_0") var cache_type_v: String = "f16"
+
+## Flash attention mode ("auto" lets llama.cpp decide per backend)
+@export_enum("auto", "enabled", "disabled") var flash_attn: String = "auto"
+
+## Keep the KV cache on the GPU when layers are offloaded
+@export var offload_kqv: bool = true
+
+## Memory budget in MB for model + KV cache (0 = disabled).
+## When set, n_ctx is an upper bound: the context shrinks to what fits.
+@export var memory_budget_mb: int = 0
+
+@export_group("Threading")
+
+## Logical cores left free for the engine (0 = inference may use every core)
+@export_range(0, 64) var reserved_cores: int = 0
+
+## Pin inference threads to the cores that are not reserved (Linux only)
+@export var pin_threads: bool = false
+
+## Nice value for inference threads, 0-19 (Linux only, 0 = default priority)
+@export_range(0, 19) var thread_nice: int = 0
+
+## Drop inference threads while the game reports frames over budget
+@export var adaptive_threads: bool = false
+
+## Frame time in ms above which a frame counts as an overrun
+@export_range(1.0, 100.0, 0.1) var frame_budget_ms: float = 20.0
+
+## Fewest threads the adaptive mode may drop to
+@export_range(1, 64) var min_threads: int = 1
+
 
 ## Returns parameters dictionary for LlamaInterface.load_model()
 func get_load_params() -> Dictionary:
-	return {
+	var params = {
 		"n_ctx": n_ctx,
 		"n_gpu_layers": n_gpu_layers,
-		"n_batch": n_batch
+		"n_batch": n_batch,
+		"type_k": cache_type_k,
+		"type_v": cache_type_v,
+		"offload_kqv": offload_kqv,
+		"reserved_cores": reserved_cores,
+		"pin_threads": pin_threads,
+		"thread_nice": thread_nice
 	}
 
+	match flash_attn:
+		"enabled":
+			params["flash_attn"] = true
+		"disabled":
+			params["flash_attn"] = false
+		_:
+			params["flash_attn"] = "auto"
+
+	if memory_budget_mb > 0:
+		params["memory_budget_mb"] = memory_budget_mb
+
+	return params
+
 
-## Applies default sampling parameters to a LlamaInterface instance
+## Applies default sampling and adaptive threading parameters to a LlamaInterface instance
 func apply_defaults_to(llama: LlamaInterface) -> void:
 	llama.temperature = default_temperature
 	llama.top_p = default_top_p
@@ -79,11 +139,16 @@ func apply_defaults_to(llama: LlamaInterface) -> void:
 	llama.max_tokens = default_max_tokens
 	llama.repeat_penalty = default_repeat_penalty
 	llama.min_p = default_min_p
+	llama.adaptive_threads = adaptive_threads
+	llama.frame_budget_ms = frame_budget_ms
+	llama.min_threads = min_threads
 
 
 ## Checks if the model file exists (either in res:// or user://)
+## A file with a pending .progress sidecar is an interrupted download.
 func is_downloaded() -> bool:
-	return FileAccess.file_exists(get_effective_path())
+	var path = get_effective_path()
+	return FileAccess.file_exists(path) and not FileAccess.file_exists(path + ".progress")
 
 
 ## Returns the filename for this model (extracted from URL or ID-based)
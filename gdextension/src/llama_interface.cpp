@@ -1,14 +1,32 @@
 #include "llama_interface.h"
 
 #include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/os.hpp>
 #include <godot_cpp/classes/project_settings.hpp>
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 
+#include <algorithm>
 #include <string>
 
+#ifdef __linux__
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 namespace godot {
 
+// Context sizes chosen by the memory budget are aligned to this many tokens
+static constexpr int64_t BUDGET_CTX_ALIGN = 256;
+
+// Consecutive on-budget frames before the adaptive mode takes a thread back
+static constexpr int32_t ADAPTIVE_RECOVERY_FRAMES = 30;
+
+// Highest nice value accepted for inference threads
+static constexpr int32_t MAX_THREAD_NICE = 19;
+
 LlamaInterface::LlamaInterface() {
 }
 
@@ -30,6 +48,119 @@ void LlamaInterface::_cleanup() {
 		m_backend_initialized = false;
 	}
 	m_model_path = "";
+	m_cache_type_k = GGML_TYPE_F16;
+	m_cache_type_v = GGML_TYPE_F16;
+	m_memory_budget_mb = 0;
+	m_n_threads = 0;
+	m_n_threads_batch = 0;
+	m_reserved_cores = 0;
+	m_cpu_affinity.clear();
+	m_thread_nice = 0;
+	m_active_threads = 0;
+}
+
+bool LlamaInterface::_parse_cache_type(const String &name, ggml_type &r_type) {
+	// Same set of KV cache types accepted by llama.cpp's --cache-type-k/-v
+	static const ggml_type supported[] = {
+		GGML_TYPE_F32,
+		GGML_TYPE_F16,
+		GGML_TYPE_BF16,
+		GGML_TYPE_Q8_0,
+		GGML_TYPE_Q4_0,
+		GGML_TYPE_Q4_1,
+		GGML_TYPE_IQ4_NL,
+		GGML_TYPE_Q5_0,
+		GGML_TYPE_Q5_1,
+	};
+
+	const String lower = name.to_lower();
+	for (ggml_type type : supported) {
+		if (lower == _cache_type_name(type)) {
+			r_type = type;
+			return true;
+		}
+	}
+	return false;
+}
+
+String LlamaInterface::_cache_type_name(ggml_type type) {
+	return String::utf8(ggml_type_name(type));
+}
+
+int64_t LlamaInterface::_kv_bytes_per_token(ggml_type type_k, ggml_type type_v) const {
+	const int64_t n_layer = llama_model_n_layer(m_model);
+	const int64_t n_embd = llama_model_n_embd(m_model);
+	const int64_t n_head = llama_model_n_head(m_model);
+	const int64_t n_head_kv = llama_model_n_head_kv(m_model);
+
+	if (n_layer <= 0 || n_embd <= 0 || n_head <= 0) {
+		return 0;
+	}
+
+	// Estimate for standard GQA models: every layer stores one K row and one V
+	// row per token, with a head size of n_embd / n_head. Sliding-window layers,
+	// custom head sizes and MLA caches are not modelled.
+	const int64_t n_embd_kv = (n_embd / n_head) * (n_head_kv > 0 ? n_head_kv : n_head);
+	const int64_t k_bytes = static_cast<int64_t>(ggml_type_size(type_k)) * n_embd_kv / ggml_blck_size(type_k);
+	const int64_t v_bytes = static_cast<int64_t>(ggml_type_size(type_v)) * n_embd_kv / ggml_blck_size(type_v);
+
+	return n_layer * (k_bytes + v_bytes);
+}
+
+bool LlamaInterface::_fit_context_to_budget(llama_context_params &ctx_params, const Dictionary &params) const {
+	const int64_t budget_bytes = m_memory_budget_mb * 1024 * 1024;
+	const int64_t model_bytes = static_cast<int64_t>(llama_model_size(m_model));
+
+	// Rough reserve for compute and logits buffers, which scale with vocabulary and
+	// the micro-batch llama.cpp actually computes (n_ubatch, never above n_batch)
+	const llama_vocab *vocab = llama_model_get_vocab(m_model);
+	const int64_t n_vocab = vocab != nullptr ? llama_vocab_n_tokens(vocab) : 0;
+	const int64_t n_embd = llama_model_n_embd(m_model);
+	const int64_t n_ubatch = std::min(ctx_params.n_ubatch, ctx_params.n_batch);
+	const int64_t compute_bytes = n_ubatch * (n_vocab + 4 * n_embd) * static_cast<int64_t>(sizeof(float));
+
+	const int64_t kv_budget = budget_bytes - model_bytes - compute_bytes;
+	const int64_t bytes_per_token = _kv_bytes_per_token(ctx_params.type_k, ctx_params.type_v);
+
+	if (bytes_per_token <= 0) {
+		UtilityFunctions::push_error("LlamaInterface: Cannot estimate KV cache size for this model");
+		return false;
+	}
+
+	int64_t total_tokens = kv_budget > 0 ? kv_budget / bytes_per_token : 0;
+	total_tokens -= total_tokens % BUDGET_CTX_ALIGN;
+
+	if (total_tokens < BUDGET_CTX_ALIGN) {
+		UtilityFunctions::push_error("LlamaInterface: memory_budget_mb (", m_memory_budget_mb,
+				") is too small, model alone needs ~", (model_bytes + compute_bytes) / (1024 * 1024), " MB");
+		return false;
+	}
+
+	// generate() only decodes sequence 0, so the whole budget goes to a single
+	// sequence; n_ctx, if given, caps it instead of being padded to fill the budget
+	int64_t n_ctx = std::min<int64_t>(total_tokens, std::max<int64_t>(llama_model_n_ctx_train(m_model), BUDGET_CTX_ALIGN));
+	if (params.has("n_ctx") && static_cast<int64_t>(params["n_ctx"]) > 0) {
+		const int64_t requested = static_cast<int64_t>(params["n_ctx"]);
+		if (requested > n_ctx) {
+			UtilityFunctions::push_warning("LlamaInterface: memory_budget_mb (", m_memory_budget_mb,
+					") only fits ", n_ctx, " of the requested ", requested, " context tokens");
+		}
+		n_ctx = std::min(n_ctx, requested);
+	}
+
+	n_ctx -= n_ctx % BUDGET_CTX_ALIGN;
+	if (n_ctx < BUDGET_CTX_ALIGN) {
+		UtilityFunctions::push_error("LlamaInterface: memory_budget_mb (", m_memory_budget_mb,
+				") leaves less than ", BUDGET_CTX_ALIGN, " context tokens");
+		return false;
+	}
+
+	ctx_params.n_ctx = static_cast<uint32_t>(n_ctx);
+
+	UtilityFunctions::print("LlamaInterface: Memory budget ", m_memory_budget_mb, " MB -> n_ctx ",
+			n_ctx, ", KV cache ~", (bytes_per_token * n_ctx) / (1024 * 1024), " MB");
+
+	return true;
 }
 
 llama_sampler *LlamaInterface::_create_sampler() const {
@@ -77,6 +208,125 @@ bool LlamaInterface::_check_stop_sequence(const std::string &text) const {
 	return false;
 }
 
+size_t LlamaInterface::_stop_prefix_length(const std::string &text) const {
+	// Longest tail of text that could still grow into a stop sequence
+	size_t longest = 0;
+	for (const auto &stop : m_stop_sequences) {
+		if (stop.empty()) {
+			continue;
+		}
+		size_t max_len = std::min(stop.length() - 1, text.length());
+		for (size_t len = max_len; len > longest; len--) {
+			if (text.compare(text.length() - len, len, stop, 0, len) == 0) {
+				longest = len;
+				break;
+			}
+		}
+	}
+	return longest;
+}
+
+std::vector<int32_t> LlamaInterface::_get_allowed_cpus() {
+	std::vector<int32_t> cpus;
+#ifdef __linux__
+	// A cpuset or container limit may leave only some CPUs, not necessarily 0..N-1
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+		for (int32_t cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+			if (CPU_ISSET(cpu, &set)) {
+				cpus.push_back(cpu);
+			}
+		}
+	}
+#endif
+	if (cpus.empty()) {
+		const int32_t n_cpus = std::max<int32_t>(OS::get_singleton()->get_processor_count(), 1);
+		for (int32_t cpu = 0; cpu < n_cpus; cpu++) {
+			cpus.push_back(cpu);
+		}
+	}
+	return cpus;
+}
+
+bool LlamaInterface::_parse_cpu_list(const Variant &value, const std::vector<int32_t> &allowed, std::vector<int32_t> &r_cpus) {
+	Array cpus;
+	switch (value.get_type()) {
+		case Variant::ARRAY:
+			cpus = value;
+			break;
+		case Variant::PACKED_INT32_ARRAY:
+			cpus = Array(PackedInt32Array(value));
+			break;
+		case Variant::PACKED_INT64_ARRAY:
+			cpus = Array(PackedInt64Array(value));
+			break;
+		default:
+			return false;
+	}
+
+	r_cpus.clear();
+	for (int i = 0; i < cpus.size(); i++) {
+		const int32_t cpu = static_cast<int32_t>(static_cast<int>(cpus[i]));
+		if (std::find(allowed.begin(), allowed.end(), cpu) == allowed.end()) {
+			return false;
+		}
+		if (std::find(r_cpus.begin(), r_cpus.end(), cpu) == r_cpus.end()) {
+			r_cpus.push_back(cpu);
+		}
+	}
+	return !r_cpus.empty();
+}
+
+void LlamaInterface::_apply_thread_isolation() const {
+#ifdef __linux__
+	// Only ever called on the thread generate() owns. llama.cpp's compute
+	// threads (OpenMP or ggml's own) are created for it and inherit both settings.
+	if (!m_cpu_affinity.empty()) {
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		for (int32_t cpu : m_cpu_affinity) {
+			CPU_SET(cpu, &set);
+		}
+		if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+			UtilityFunctions::push_warning("LlamaInterface: Failed to set CPU affinity for inference threads");
+		}
+	}
+
+	if (m_thread_nice > 0) {
+		const id_t tid = static_cast<id_t>(syscall(SYS_gettid));
+		// Unprivileged processes cannot raise the priority back, only lower it further
+		if (getpriority(PRIO_PROCESS, tid) < m_thread_nice && setpriority(PRIO_PROCESS, tid, m_thread_nice) != 0) {
+			UtilityFunctions::push_warning("LlamaInterface: Failed to lower inference thread priority");
+		}
+	}
+#endif
+}
+
+int32_t LlamaInterface::_adapt_thread_count() {
+	const int32_t current = m_active_threads.load();
+	const int32_t floor = std::min(m_min_threads.load(), m_n_threads);
+	int32_t target = current;
+
+	if (m_frame_overruns.exchange(0) > 0) {
+		// The game missed its frame budget since the last step: give a core back
+		target = std::max(current - 1, floor);
+		m_frames_on_budget = 0;
+	} else if (m_frames_on_budget.load() >= ADAPTIVE_RECOVERY_FRAMES) {
+		// Frames have been on budget for a while: take a core again
+		target = std::min(current + 1, m_n_threads);
+		m_frames_on_budget = 0;
+	}
+
+	if (target == current) {
+		return 0;
+	}
+
+	llama_set_n_threads(m_context, target, m_n_threads_batch);
+	m_active_threads = target;
+	return 1;
+}
+
 void LlamaInterface::_bind_methods() {
 	// Model management
 	ClassDB::bind_method(D_METHOD("load_model", "path", "params"), &LlamaInterface::load_model, DEFVAL(Dictionary()));
@@ -88,6 +338,10 @@ void LlamaInterface::_bind_methods() {
 	// Text generation
 	ClassDB::bind_method(D_METHOD("generate", "prompt"), &LlamaInterface::generate);
 
+	// Streaming output
+	ClassDB::bind_method(D_METHOD("set_chunk_pipeline", "pipeline"), &LlamaInterface::set_chunk_pipeline);
+	ClassDB::bind_method(D_METHOD("get_chunk_pipeline"), &LlamaInterface::get_chunk_pipeline);
+
 	// Sampling parameters
 	ClassDB::bind_method(D_METHOD("set_temperature", "temperature"), &LlamaInterface::set_temperature);
 	ClassDB::bind_method(D_METHOD("get_temperature"), &LlamaInterface::get_temperature);
@@ -120,6 +374,17 @@ void LlamaInterface::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_timeout"), &LlamaInterface::get_timeout);
 	ClassDB::bind_method(D_METHOD("has_generation_timed_out"), &LlamaInterface::has_generation_timed_out);
 
+	// Threading
+	ClassDB::bind_method(D_METHOD("set_adaptive_threads", "enabled"), &LlamaInterface::set_adaptive_threads);
+	ClassDB::bind_method(D_METHOD("get_adaptive_threads"), &LlamaInterface::get_adaptive_threads);
+	ClassDB::bind_method(D_METHOD("set_frame_budget_ms", "budget_ms"), &LlamaInterface::set_frame_budget_ms);
+	ClassDB::bind_method(D_METHOD("get_frame_budget_ms"), &LlamaInterface::get_frame_budget_ms);
+	ClassDB::bind_method(D_METHOD("set_min_threads", "n_threads"), &LlamaInterface::set_min_threads);
+	ClassDB::bind_method(D_METHOD("get_min_threads"), &LlamaInterface::get_min_threads);
+	ClassDB::bind_method(D_METHOD("report_frame_time", "frame_ms"), &LlamaInterface::report_frame_time);
+	ClassDB::bind_method(D_METHOD("get_active_threads"), &LlamaInterface::get_active_threads);
+	ClassDB::bind_method(D_METHOD("get_generation_stats"), &LlamaInterface::get_generation_stats);
+
 	// Signals
 	ADD_SIGNAL(MethodInfo("generation_timeout"));
 
@@ -135,6 +400,11 @@ void LlamaInterface::_bind_methods() {
 
 	ADD_GROUP("Timeout", "");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "timeout", PROPERTY_HINT_RANGE, "0,300000,100"), "set_timeout", "get_timeout");
+
+	ADD_GROUP("Threading", "");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "adaptive_threads"), "set_adaptive_threads", "get_adaptive_threads");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "frame_budget_ms", PROPERTY_HINT_RANGE, "1.0,100.0,0.1"), "set_frame_budget_ms", "get_frame_budget_ms");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "min_threads", PROPERTY_HINT_RANGE, "1,64,1"), "set_min_threads", "get_min_threads");
 }
 
 Error LlamaInterface::load_model(const String &path, const Dictionary &params) {
@@ -155,6 +425,71 @@ Error LlamaInterface::load_model(const String &path, const Dictionary &params) {
 		return ERR_FILE_NOT_FOUND;
 	}
 
+	// Validate KV cache options before paying for the model load
+	ggml_type cache_type_k = GGML_TYPE_F16;
+	ggml_type cache_type_v = GGML_TYPE_F16;
+	if (params.has("type_k") && !_parse_cache_type(params["type_k"], cache_type_k)) {
+		UtilityFunctions::push_error("LlamaInterface: Unsupported type_k: ", params["type_k"]);
+		return ERR_INVALID_PARAMETER;
+	}
+	if (params.has("type_v") && !_parse_cache_type(params["type_v"], cache_type_v)) {
+		UtilityFunctions::push_error("LlamaInterface: Unsupported type_v: ", params["type_v"]);
+		return ERR_INVALID_PARAMETER;
+	}
+
+	llama_flash_attn_type flash_attn = LLAMA_FLASH_ATTN_TYPE_AUTO;
+	if (params.has("flash_attn")) {
+		const Variant value = params["flash_attn"];
+		if (value.get_type() == Variant::BOOL) {
+			flash_attn = static_cast<bool>(value) ? LLAMA_FLASH_ATTN_TYPE_ENABLED : LLAMA_FLASH_ATTN_TYPE_DISABLED;
+		} else if (String(value) != "auto") {
+			UtilityFunctions::push_error("LlamaInterface: flash_attn must be a bool or \"auto\"");
+			return ERR_INVALID_PARAMETER;
+		}
+	}
+
+	// llama.cpp only supports a quantized V cache through flash attention
+	if (ggml_is_quantized(cache_type_v) && flash_attn == LLAMA_FLASH_ATTN_TYPE_DISABLED) {
+		UtilityFunctions::push_warning("LlamaInterface: Quantized type_v requires flash attention, enabling it");
+		flash_attn = LLAMA_FLASH_ATTN_TYPE_ENABLED;
+	}
+
+	// Thread isolation: cores left to the engine, pinning and priority
+	const std::vector<int32_t> allowed_cpus = _get_allowed_cpus();
+	const int32_t n_cpus = static_cast<int32_t>(allowed_cpus.size());
+	int32_t reserved_cores = 0;
+	if (params.has("reserved_cores")) {
+		reserved_cores = std::clamp<int32_t>(static_cast<int32_t>(static_cast<int>(params["reserved_cores"])), 0, n_cpus - 1);
+	}
+
+	std::vector<int32_t> cpu_affinity;
+	if (params.has("cpu_affinity")) {
+		if (!_parse_cpu_list(params["cpu_affinity"], allowed_cpus, cpu_affinity)) {
+			PackedInt32Array allowed;
+			for (int32_t cpu : allowed_cpus) {
+				allowed.push_back(cpu);
+			}
+			UtilityFunctions::push_error("LlamaInterface: cpu_affinity must list CPUs this process may run on: ", allowed);
+			return ERR_INVALID_PARAMETER;
+		}
+	} else if (params.has("pin_threads") && static_cast<bool>(params["pin_threads"])) {
+		// Pin to the highest-numbered allowed cores; the reserved ones stay free for the engine
+		cpu_affinity.assign(allowed_cpus.begin() + reserved_cores, allowed_cpus.end());
+	}
+
+	int32_t thread_nice = 0;
+	if (params.has("thread_nice")) {
+		thread_nice = std::clamp<int32_t>(static_cast<int32_t>(static_cast<int>(params["thread_nice"])), 0, MAX_THREAD_NICE);
+	}
+
+#ifndef __linux__
+	if (!cpu_affinity.empty() || thread_nice > 0) {
+		UtilityFunctions::push_warning("LlamaInterface: cpu_affinity, pin_threads and thread_nice are only supported on Linux");
+		cpu_affinity.clear();
+		thread_nice = 0;
+	}
+#endif
+
 	// Initialize backend
 	llama_backend_init();
 	m_backend_initialized = true;
@@ -201,6 +536,37 @@ Error LlamaInterface::load_model(const String &path, const Dictionary &params) {
 		ctx_params.n_threads_batch = static_cast<int32_t>(static_cast<int>(params["n_threads_batch"]));
 	}
 
+	// Inference never uses more threads than the cores it is allowed to run on
+	int32_t max_threads = n_cpus - reserved_cores;
+	if (!cpu_affinity.empty()) {
+		max_threads = std::min<int32_t>(max_threads, static_cast<int32_t>(cpu_affinity.size()));
+	}
+	if (reserved_cores > 0 || !cpu_affinity.empty()) {
+		if (!params.has("n_threads")) {
+			ctx_params.n_threads = max_threads;
+		}
+		if (!params.has("n_threads_batch")) {
+			ctx_params.n_threads_batch = max_threads;
+		}
+	}
+	ctx_params.n_threads = std::clamp<int32_t>(ctx_params.n_threads, 1, max_threads);
+	ctx_params.n_threads_batch = std::clamp<int32_t>(ctx_params.n_threads_batch, 1, max_threads);
+	if (params.has("offload_kqv")) {
+		ctx_params.offload_kqv = static_cast<bool>(params["offload_kqv"]);
+	}
+	ctx_params.type_k = cache_type_k;
+	ctx_params.type_v = cache_type_v;
+	ctx_params.flash_attn_type = flash_attn;
+
+	// Memory budget sizes n_ctx to what fits, with a requested n_ctx as the upper bound
+	if (params.has("memory_budget_mb")) {
+		m_memory_budget_mb = static_cast<int64_t>(params["memory_budget_mb"]);
+	}
+	if (m_memory_budget_mb > 0 && !_fit_context_to_budget(ctx_params, params)) {
+		_cleanup();
+		return ERR_OUT_OF_MEMORY;
+	}
+
 	// Create context
 	m_context = llama_init_from_model(m_model, ctx_params);
 
@@ -211,6 +577,14 @@ Error LlamaInterface::load_model(const String &path, const Dictionary &params) {
 	}
 
 	m_model_path = path;
+	m_cache_type_k = cache_type_k;
+	m_cache_type_v = cache_type_v;
+	m_n_threads = llama_n_threads(m_context);
+	m_n_threads_batch = llama_n_threads_batch(m_context);
+	m_active_threads = m_n_threads;
+	m_reserved_cores = reserved_cores;
+	m_cpu_affinity = cpu_affinity;
+	m_thread_nice = thread_nice;
 	UtilityFunctions::print("LlamaInterface: Model loaded successfully: ", path);
 
 	return OK;
@@ -259,6 +633,23 @@ Dictionary LlamaInterface::get_model_info() const {
 	info["n_ctx"] = static_cast<int32_t>(llama_n_ctx(m_context));
 	info["n_batch"] = static_cast<int32_t>(llama_n_batch(m_context));
 
+	// KV cache info
+	info["type_k"] = _cache_type_name(m_cache_type_k);
+	info["type_v"] = _cache_type_name(m_cache_type_v);
+	info["kv_cache_bytes_estimate"] = _kv_bytes_per_token(m_cache_type_k, m_cache_type_v) * static_cast<int64_t>(llama_n_ctx(m_context));
+	info["memory_budget_mb"] = m_memory_budget_mb;
+
+	// Threading info
+	PackedInt32Array cpu_affinity;
+	for (int32_t cpu : m_cpu_affinity) {
+		cpu_affinity.push_back(cpu);
+	}
+	info["n_threads"] = m_n_threads;
+	info["n_threads_batch"] = m_n_threads_batch;
+	info["reserved_cores"] = m_reserved_cores;
+	info["cpu_affinity"] = cpu_affinity;
+	info["thread_nice"] = m_thread_nice;
+
 	// Vocabulary info
 	const llama_vocab *vocab = llama_model_get_vocab(m_model);
 	if (vocab != nullptr) {
@@ -294,6 +685,33 @@ String LlamaInterface::get_model_path() const {
 // ==================== Text Generation ====================
 
 String LlamaInterface::generate(const String &prompt) {
+	if (m_cpu_affinity.empty() && m_thread_nice == 0) {
+		return _generate(prompt);
+	}
+
+	// Main-thread callers get their signals inline, so generation stays on that thread
+	OS *os = OS::get_singleton();
+	if (os->get_thread_caller_id() == os->get_main_thread_id()) {
+		if (!m_warned_main_thread) {
+			UtilityFunctions::push_warning("LlamaInterface: Thread affinity and priority are ignored when generate() runs on the main thread");
+			m_warned_main_thread = true;
+		}
+		return _generate(prompt);
+	}
+
+	// Decode on a thread of our own so the caller (often a pooled engine thread)
+	// is never pinned or reniced. OpenMP keeps one worker team per master thread,
+	// so a fresh thread also gets fresh workers, which exit when it does.
+	String result;
+	std::thread worker([this, &prompt, &result]() {
+		_apply_thread_isolation();
+		result = _generate(prompt);
+	});
+	worker.join();
+	return result;
+}
+
+String LlamaInterface::_generate(const String &prompt) {
 	// Reset timeout flag
 	m_generation_timed_out = false;
 
@@ -336,6 +754,15 @@ String LlamaInterface::generate(const String &prompt) {
 	// Clear the memory/KV cache for fresh generation
 	llama_memory_clear(llama_get_memory(m_context), true);
 
+	// Adaptive mode starts from the last thread count, otherwise use them all
+	m_frame_overruns = 0;
+	m_frames_on_budget = 0;
+	if (!m_adaptive_threads && m_active_threads != m_n_threads) {
+		llama_set_n_threads(m_context, m_n_threads, m_n_threads_batch);
+		m_active_threads = m_n_threads;
+	}
+	int32_t thread_adjustments = 0;
+
 	// Create sampler
 	llama_sampler *smpl = _create_sampler();
 
@@ -343,6 +770,7 @@ String LlamaInterface::generate(const String &prompt) {
 	llama_batch batch = llama_batch_get_one(tokens.data(), tokens.size());
 
 	// Decode prompt
+	auto prompt_start = std::chrono::steady_clock::now();
 	if (llama_decode(m_context, batch) != 0) {
 		UtilityFunctions::push_error("LlamaInterface: Failed to decode prompt");
 		llama_sampler_free(smpl);
@@ -352,6 +780,13 @@ String LlamaInterface::generate(const String &prompt) {
 	// Generation loop
 	std::string generated_text;
 	int n_decoded = 0;
+	int n_generated = 0;
+
+	// Bytes of generated_text already handed to the chunk pipeline
+	size_t n_streamed = 0;
+	if (m_chunk_pipeline.is_valid()) {
+		m_chunk_pipeline->begin_stream();
+	}
 
 	// Start time for timeout check
 	auto start_time = std::chrono::steady_clock::now();
@@ -387,6 +822,7 @@ String LlamaInterface::generate(const String &prompt) {
 
 		std::string piece(buf, n);
 		generated_text += piece;
+		n_generated++;
 
 		// Check for stop sequences
 		if (_check_stop_sequence(generated_text)) {
@@ -401,6 +837,20 @@ String LlamaInterface::generate(const String &prompt) {
 			break;
 		}
 
+		// Stream new text, holding back anything that may become a stop sequence
+		if (m_chunk_pipeline.is_valid()) {
+			size_t streamable = generated_text.length() - _stop_prefix_length(generated_text);
+			if (streamable > n_streamed) {
+				m_chunk_pipeline->push_utf8(generated_text.data() + n_streamed, streamable - n_streamed);
+				n_streamed = streamable;
+			}
+		}
+
+		// Between decode steps: follow the frame overruns reported by the game
+		if (m_adaptive_threads) {
+			thread_adjustments += _adapt_thread_count();
+		}
+
 		// Prepare batch for next token
 		batch = llama_batch_get_one(&new_token, 1);
 
@@ -413,12 +863,48 @@ String LlamaInterface::generate(const String &prompt) {
 		n_decoded++;
 	}
 
+	// Flush the last partial sentence to the pipeline
+	if (m_chunk_pipeline.is_valid()) {
+		if (generated_text.length() > n_streamed) {
+			m_chunk_pipeline->push_utf8(generated_text.data() + n_streamed, generated_text.length() - n_streamed);
+		}
+		m_chunk_pipeline->end_stream();
+	}
+
 	// Cleanup
 	llama_sampler_free(smpl);
 
+	// Record timing statistics
+	auto end_time = std::chrono::steady_clock::now();
+	const double prompt_ms = std::chrono::duration<double, std::milli>(start_time - prompt_start).count();
+	const double generation_ms = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+
+	Dictionary stats;
+	stats["prompt_tokens"] = static_cast<int>(tokens.size());
+	stats["generated_tokens"] = n_generated;
+	stats["prompt_ms"] = prompt_ms;
+	stats["generation_ms"] = generation_ms;
+	stats["tokens_per_second"] = generation_ms > 0.0 ? n_generated * 1000.0 / generation_ms : 0.0;
+	stats["n_threads"] = m_active_threads.load();
+	stats["thread_adjustments"] = thread_adjustments;
+	{
+		std::lock_guard<std::mutex> lock(m_stats_mutex);
+		m_generation_stats = stats;
+	}
+
 	return String::utf8(generated_text.c_str());
 }
 
+// ==================== Streaming Output ====================
+
+void LlamaInterface::set_chunk_pipeline(const Ref<TextChunkPipeline> &pipeline) {
+	m_chunk_pipeline = pipeline;
+}
+
+Ref<TextChunkPipeline> LlamaInterface::get_chunk_pipeline() const {
+	return m_chunk_pipeline;
+}
+
 // ==================== Sampling Parameters ====================
 
 void LlamaInterface::set_temperature(float temperature) {
@@ -537,4 +1023,47 @@ bool LlamaInterface::has_generation_timed_out() const {
 	return m_generation_timed_out;
 }
 
+// ==================== Threading ====================
+
+void LlamaInterface::set_adaptive_threads(bool enabled) {
+	m_adaptive_threads = enabled;
+}
+
+bool LlamaInterface::get_adaptive_threads() const {
+	return m_adaptive_threads;
+}
+
+void LlamaInterface::set_frame_budget_ms(float budget_ms) {
+	m_frame_budget_ms = budget_ms > 1.0f ? budget_ms : 1.0f;
+}
+
+float LlamaInterface::get_frame_budget_ms() const {
+	return m_frame_budget_ms;
+}
+
+void LlamaInterface::set_min_threads(int32_t n_threads) {
+	m_min_threads = n_threads > 0 ? n_threads : 1;
+}
+
+int32_t LlamaInterface::get_min_threads() const {
+	return m_min_threads;
+}
+
+void LlamaInterface::report_frame_time(float frame_ms) {
+	if (frame_ms > m_frame_budget_ms) {
+		m_frame_overruns++;
+	} else {
+		m_frames_on_budget++;
+	}
+}
+
+int32_t LlamaInterface::get_active_threads() const {
+	return m_active_threads;
+}
+
+Dictionary LlamaInterface::get_generation_stats() const {
+	std::lock_guard<std::mutex> lock(m_stats_mutex);
+	return m_generation_stats.duplicate();
+}
+
 } // namespace godot
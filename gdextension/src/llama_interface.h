@@ -3,13 +3,18 @@
 
 #include <godot_cpp/classes/ref_counted.hpp>
 #include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
 #include <godot_cpp/variant/packed_string_array.hpp>
 #include <godot_cpp/variant/string.hpp>
 
 #include "llama.h"
+#include "text_chunk_pipeline.h"
 
+#include <atomic>
 #include <chrono>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace godot {
@@ -45,10 +50,48 @@ private:
 	int64_t m_timeout_ms = 0; // 0 = no timeout
 	bool m_generation_timed_out = false;
 
+	// Streaming output stage (optional)
+	Ref<TextChunkPipeline> m_chunk_pipeline;
+
+	// KV cache configuration (as applied at load time)
+	ggml_type m_cache_type_k = GGML_TYPE_F16;
+	ggml_type m_cache_type_v = GGML_TYPE_F16;
+	int64_t m_memory_budget_mb = 0; // 0 = budget mode disabled
+
+	// Thread isolation (as applied at load time)
+	int32_t m_n_threads = 0;
+	int32_t m_n_threads_batch = 0;
+	int32_t m_reserved_cores = 0;
+	std::vector<int32_t> m_cpu_affinity; // empty = not pinned
+	int32_t m_thread_nice = 0; // 0 = default priority
+	bool m_warned_main_thread = false;
+
+	// Adaptive thread count driven by frame overruns reported by the game
+	std::atomic<bool> m_adaptive_threads{ false };
+	std::atomic<float> m_frame_budget_ms{ 20.0f };
+	std::atomic<int32_t> m_min_threads{ 1 };
+	std::atomic<int32_t> m_active_threads{ 0 };
+	std::atomic<int32_t> m_frame_overruns{ 0 };
+	std::atomic<int32_t> m_frames_on_budget{ 0 };
+
+	// Statistics of the last generation (guarded by m_stats_mutex)
+	mutable std::mutex m_stats_mutex;
+	Dictionary m_generation_stats;
+
 	// Internal methods
 	void _cleanup();
+	static bool _parse_cache_type(const String &name, ggml_type &r_type);
+	static String _cache_type_name(ggml_type type);
+	int64_t _kv_bytes_per_token(ggml_type type_k, ggml_type type_v) const; // estimate, see .cpp
+	bool _fit_context_to_budget(llama_context_params &ctx_params, const Dictionary &params) const;
 	llama_sampler *_create_sampler() const;
 	bool _check_stop_sequence(const std::string &text) const;
+	size_t _stop_prefix_length(const std::string &text) const;
+	static std::vector<int32_t> _get_allowed_cpus();
+	static bool _parse_cpu_list(const Variant &value, const std::vector<int32_t> &allowed, std::vector<int32_t> &r_cpus);
+	void _apply_thread_isolation() const;
+	int32_t _adapt_thread_count();
+	String _generate(const String &prompt);
 
 protected:
 	static void _bind_methods();
@@ -61,7 +104,10 @@ public:
 
 	/// Load a GGUF model from the specified path.
 	/// @param path Path to the .gguf model file (supports user:// and res://)
-	/// @param params Optional parameters: n_ctx (int), n_gpu_layers (int), use_mmap (bool), use_mlock (bool)
+	/// @param params Optional parameters: n_ctx (int), n_gpu_layers (int), use_mmap (bool), use_mlock (bool),
+	///               type_k/type_v (String), flash_attn (bool or "auto"), memory_budget_mb (int),
+	///               n_threads/n_threads_batch (int), reserved_cores (int), pin_threads (bool),
+	///               cpu_affinity (PackedInt32Array), thread_nice (int)
 	/// @return OK on success, or an error code
 	Error load_model(const String &path, const Dictionary &params = Dictionary());
 
@@ -87,6 +133,12 @@ public:
 	/// @return Generated text, or empty string on error
 	String generate(const String &prompt);
 
+	// ==================== Streaming Output ====================
+
+	/// Attach a pipeline that receives the output in sentence/clause chunks while generating
+	void set_chunk_pipeline(const Ref<TextChunkPipeline> &pipeline);
+	Ref<TextChunkPipeline> get_chunk_pipeline() const;
+
 	// ==================== Sampling Parameters ====================
 
 	/// Set the temperature for sampling (0.0 = greedy, higher = more random)
@@ -146,6 +198,29 @@ public:
 
 	/// Check if the last generation timed out
 	bool has_generation_timed_out() const;
+
+	// ==================== Threading ====================
+
+	/// Shrink n_threads between decode steps while the game reports frame overruns
+	void set_adaptive_threads(bool enabled);
+	bool get_adaptive_threads() const;
+
+	/// Frames longer than this (in ms) count as overruns
+	void set_frame_budget_ms(float budget_ms);
+	float get_frame_budget_ms() const;
+
+	/// Lower bound for the adaptive thread count
+	void set_min_threads(int32_t n_threads);
+	int32_t get_min_threads() const;
+
+	/// Report the duration of a game frame (thread-safe, call from _process)
+	void report_frame_time(float frame_ms);
+
+	/// Threads currently used for token generation
+	int32_t get_active_threads() const;
+
+	/// Timing and thread statistics of the last generate() call
+	Dictionary get_generation_stats() const;
 };
 
 } // namespace godot
@@ -0,0 +1,1106 @@
+#include "parallel_downloader.h"
+
+#include <godot_cpp/classes/dir_access.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/json.hpp>
+#include <godot_cpp/classes/project_settings.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <algorithm>
+#include <chrono>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace godot {
+
+static constexpr const char *USER_AGENT = "OhMyDialogSystem/1.0 (Godot GDExtension)";
+static constexpr int32_t MAX_REDIRECTS = 8;
+static constexpr int32_t MAX_CONNECTIONS = 16;
+static constexpr int32_t READ_CHUNK_SIZE = 64 * 1024;
+static constexpr int64_t MIN_SEGMENT_SIZE = 256 * 1024;
+
+// A connection that delivers no data for this long is dropped and retried
+static constexpr int64_t STALL_TIMEOUT_MS = 30000;
+
+// Segments a worker may run ahead of the hash frontier, per connection.
+// Bounds the memory held for out-of-order segments waiting to be hashed.
+static constexpr int64_t HASH_WINDOW_PER_CONNECTION = 2;
+
+// Platform file helpers, defined with the positional I/O below
+static bool replace_file(const String &from, const String &to);
+static bool write_file_atomic(const String &path, const CharString &data);
+
+static void sleep_ms(int64_t ms) {
+	std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+ParallelDownloader::ParallelDownloader() {
+}
+
+ParallelDownloader::~ParallelDownloader() {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_cancel_requested = true;
+	}
+	m_hash_advanced.notify_all();
+	_join();
+	_close_target();
+}
+
+void ParallelDownloader::_bind_methods() {
+	// Download control
+	ClassDB::bind_method(D_METHOD("start", "url", "path", "options"), &ParallelDownloader::start, DEFVAL(Dictionary()));
+	ClassDB::bind_method(D_METHOD("cancel"), &ParallelDownloader::cancel);
+	ClassDB::bind_method(D_METHOD("wait"), &ParallelDownloader::wait);
+
+	// Status
+	ClassDB::bind_method(D_METHOD("get_status"), &ParallelDownloader::get_status);
+	ClassDB::bind_method(D_METHOD("is_running"), &ParallelDownloader::is_running);
+	ClassDB::bind_method(D_METHOD("get_downloaded_bytes"), &ParallelDownloader::get_downloaded_bytes);
+	ClassDB::bind_method(D_METHOD("get_total_bytes"), &ParallelDownloader::get_total_bytes);
+	ClassDB::bind_method(D_METHOD("get_progress"), &ParallelDownloader::get_progress);
+	ClassDB::bind_method(D_METHOD("get_sha256"), &ParallelDownloader::get_sha256);
+	ClassDB::bind_method(D_METHOD("get_error"), &ParallelDownloader::get_error);
+	ClassDB::bind_method(D_METHOD("get_error_message"), &ParallelDownloader::get_error_message);
+	ClassDB::bind_method(D_METHOD("get_target_path"), &ParallelDownloader::get_target_path);
+
+	// Signals (emitted deferred, on the main thread)
+	ADD_SIGNAL(MethodInfo("download_completed", PropertyInfo(Variant::STRING, "path"), PropertyInfo(Variant::STRING, "sha256")));
+	ADD_SIGNAL(MethodInfo("download_failed", PropertyInfo(Variant::INT, "error"), PropertyInfo(Variant::STRING, "message")));
+	ADD_SIGNAL(MethodInfo("download_cancelled"));
+
+	BIND_ENUM_CONSTANT(STATUS_IDLE);
+	BIND_ENUM_CONSTANT(STATUS_DOWNLOADING);
+	BIND_ENUM_CONSTANT(STATUS_COMPLETED);
+	BIND_ENUM_CONSTANT(STATUS_FAILED);
+	BIND_ENUM_CONSTANT(STATUS_CANCELLED);
+}
+
+// ==================== Download Control ====================
+
+Error ParallelDownloader::start(const String &url, const String &path, const Dictionary &options) {
+	if (is_running()) {
+		UtilityFunctions::push_error("ParallelDownloader: Already downloading ", m_url);
+		return ERR_BUSY;
+	}
+
+	UrlParts parts;
+	if (!_parse_url(url, parts)) {
+		UtilityFunctions::push_error("ParallelDownloader: Unsupported URL: ", url);
+		return ERR_INVALID_PARAMETER;
+	}
+	if (path.is_empty()) {
+		UtilityFunctions::push_error("ParallelDownloader: Target path is empty");
+		return ERR_INVALID_PARAMETER;
+	}
+
+	// Previous run may still be finishing its bookkeeping
+	_join();
+
+	m_url = url;
+	m_resolved_url = url;
+	m_target_path = path;
+	m_target_global = path;
+	if (path.begins_with("res://") || path.begins_with("user://")) {
+		m_target_global = ProjectSettings::get_singleton()->globalize_path(path);
+	}
+	m_part_global = m_target_global + ".part";
+
+	m_connections = 4;
+	if (options.has("connections")) {
+		m_connections = std::clamp(static_cast<int32_t>(static_cast<int>(options["connections"])), 1, MAX_CONNECTIONS);
+	}
+
+	// Segments stay a multiple of the SHA-256 block so the hash state can be persisted
+	m_segment_size = 4 * 1024 * 1024;
+	if (options.has("segment_size")) {
+		m_segment_size = std::max(static_cast<int64_t>(options["segment_size"]), MIN_SEGMENT_SIZE);
+	}
+	m_segment_size -= m_segment_size % static_cast<int64_t>(Sha256::BLOCK_SIZE);
+
+	m_max_retries = options.has("max_retries") ? std::max(static_cast<int32_t>(static_cast<int>(options["max_retries"])), 0) : 3;
+	m_resume = options.has("resume") ? static_cast<bool>(options["resume"]) : true;
+	m_headers = options.has("headers") ? PackedStringArray(options["headers"]) : PackedStringArray();
+
+	m_expected_sha256.clear();
+	if (options.has("sha256")) {
+		CharString sha_utf8 = String(options["sha256"]).strip_edges().to_lower().utf8();
+		m_expected_sha256 = sha_utf8.get_data();
+	}
+
+	// Make sure the destination directory exists
+	String base_dir = m_target_global.get_base_dir();
+	if (!base_dir.is_empty() && !DirAccess::dir_exists_absolute(base_dir)) {
+		DirAccess::make_dir_recursive_absolute(base_dir);
+	}
+
+	// Reset shared state
+	m_cancel_requested = false;
+	m_downloaded_bytes = 0;
+	m_total_bytes = 0;
+	m_next_segment = 0;
+	m_segment_count = 0;
+	m_ranges_supported = false;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_segment_done.clear();
+		m_pending_hash.clear();
+		m_hash_next = 0;
+		m_sha.reset();
+		m_sha256_hex.clear();
+		m_error = OK;
+		m_error_message = "";
+	}
+
+	m_status = STATUS_DOWNLOADING;
+	m_coordinator = std::thread(&ParallelDownloader::_run, this);
+
+	return OK;
+}
+
+void ParallelDownloader::cancel() {
+	if (!is_running()) {
+		return;
+	}
+	{
+		// Set under the lock so a worker about to wait cannot miss the wakeup
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_cancel_requested = true;
+	}
+	m_hash_advanced.notify_all();
+	_join();
+}
+
+void ParallelDownloader::wait() {
+	_join();
+}
+
+void ParallelDownloader::_join() {
+	if (m_coordinator.joinable() && m_coordinator.get_id() != std::this_thread::get_id()) {
+		m_coordinator.join();
+	}
+}
+
+void ParallelDownloader::_fail(Error error, const String &message) {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_error == OK) {
+			m_error = error;
+			m_error_message = message;
+		}
+		m_status = STATUS_FAILED;
+	}
+	m_hash_advanced.notify_all();
+}
+
+// ==================== Coordinator ====================
+
+void ParallelDownloader::_run() {
+	int64_t total = -1;
+	bool ranges = false;
+
+	bool ok = _probe(total, ranges);
+
+	if (ok) {
+		m_total_bytes = total > 0 ? total : 0;
+		m_ranges_supported = ranges && total > 0;
+
+		if (m_ranges_supported) {
+			m_segment_count = (total + m_segment_size - 1) / m_segment_size;
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_segment_done.assign(static_cast<size_t>(m_segment_count), 0);
+			}
+
+			bool resumed = m_resume && _load_progress();
+			if (!_open_target(!resumed)) {
+				_fail(ERR_FILE_CANT_WRITE, "Cannot open target file: " + m_target_path);
+			} else if (!resumed) {
+				// Record the empty progress before the file grows to full size
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					_save_progress_locked();
+				}
+				if (!_preallocate(total)) {
+					_close_target();
+					_discard_partial();
+					_fail(ERR_FILE_CANT_WRITE, "Cannot allocate " + String::num_int64(total) + " bytes for " + m_target_path);
+				}
+			}
+
+			if (m_status == STATUS_DOWNLOADING && resumed) {
+				int64_t done_bytes = 0;
+				for (int64_t i = 0; i < m_segment_count; i++) {
+					if (m_segment_done[i]) {
+						done_bytes += _segment_length(i);
+					}
+				}
+				m_downloaded_bytes = done_bytes;
+				UtilityFunctions::print("ParallelDownloader: Resuming ", m_target_path, " at ", done_bytes, "/", total, " bytes");
+
+				// Move the hash frontier past segments already on disk so workers are not held back
+				std::unique_lock<std::mutex> lock(m_mutex);
+				if (!_advance_hash_locked()) {
+					lock.unlock();
+					_fail(ERR_FILE_CANT_READ, "Cannot read back previously downloaded data");
+				}
+			}
+
+			if (m_status == STATUS_DOWNLOADING) {
+				int64_t n_workers = std::min<int64_t>(m_connections, m_segment_count);
+				std::vector<std::thread> workers;
+				workers.reserve(static_cast<size_t>(n_workers));
+				for (int64_t i = 0; i < n_workers; i++) {
+					workers.emplace_back(&ParallelDownloader::_worker, this);
+				}
+				for (std::thread &worker : workers) {
+					worker.join();
+				}
+
+				// Hash any trailing segments finished by a previous session
+				std::unique_lock<std::mutex> lock(m_mutex);
+				bool hashed = _advance_hash_locked();
+				bool complete = m_hash_next == m_segment_count;
+				_save_progress_locked();
+				lock.unlock();
+
+				if (!hashed) {
+					_fail(ERR_FILE_CANT_READ, "Cannot read back previously downloaded data");
+				} else if (!complete && !m_cancel_requested && m_status == STATUS_DOWNLOADING) {
+					_fail(ERR_BUG, "Download ended with missing segments");
+				}
+			}
+			_close_target();
+		} else {
+			_download_single();
+		}
+	}
+
+	// Without a sidecar the partial file is useless, so it is never left behind
+	const bool resumable = m_ranges_supported && m_resume;
+
+	if (m_cancel_requested && m_status == STATUS_DOWNLOADING) {
+		m_status = STATUS_CANCELLED;
+		if (resumable) {
+			UtilityFunctions::print("ParallelDownloader: Download cancelled, progress kept for resume: ", m_target_path);
+		} else {
+			_discard_partial();
+			UtilityFunctions::print("ParallelDownloader: Download cancelled: ", m_target_path);
+		}
+		call_deferred("emit_signal", "download_cancelled");
+		return;
+	}
+
+	if (m_status == STATUS_DOWNLOADING) {
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_sha256_hex = m_sha.finalize_hex();
+		bool mismatch = !m_expected_sha256.empty() && m_expected_sha256 != m_sha256_hex;
+		String actual = String::utf8(m_sha256_hex.c_str());
+		lock.unlock();
+
+		if (mismatch) {
+			// Corrupt data cannot be resumed, start over next time
+			_discard_partial();
+			_fail(ERR_FILE_CORRUPT, "SHA-256 mismatch: expected " + String::utf8(m_expected_sha256.c_str()) + ", got " + actual);
+		} else if (!_finalize_target()) {
+			_fail(ERR_FILE_CANT_WRITE, "Cannot move the finished download to " + m_target_path);
+		} else {
+			m_status = STATUS_COMPLETED;
+			call_deferred("emit_signal", "download_completed", m_target_path, actual);
+			return;
+		}
+	} else if (ok && !resumable) {
+		_discard_partial();
+	}
+
+	Error error;
+	String message;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		error = m_error;
+		message = m_error_message;
+	}
+	UtilityFunctions::push_error("ParallelDownloader: ", message);
+	call_deferred("emit_signal", "download_failed", static_cast<int>(error), message);
+}
+
+bool ParallelDownloader::_probe(int64_t &r_total, bool &r_ranges) {
+	String url = m_url;
+
+	for (int32_t redirect = 0; redirect <= MAX_REDIRECTS; redirect++) {
+		// A one-byte range request tells us the size and whether ranges are honoured
+		PackedStringArray headers = m_headers;
+		headers.push_back("Range: bytes=0-0");
+
+		Ref<HTTPClient> client;
+		Error err = _open_request(client, url, headers);
+		if (err != OK) {
+			if (!m_cancel_requested) {
+				_fail(ERR_CANT_CONNECT, "Cannot connect to " + url);
+			}
+			return false;
+		}
+
+		int32_t code = client->get_response_code();
+		PackedStringArray response_headers = client->get_response_headers();
+		client->close();
+
+		if (code == 301 || code == 302 || code == 303 || code == 307 || code == 308) {
+			String location = _find_header(response_headers, "Location");
+			if (location.is_empty()) {
+				_fail(ERR_INVALID_DATA, "Redirect without Location header");
+				return false;
+			}
+			if (location.begins_with("/")) {
+				UrlParts parts;
+				_parse_url(url, parts);
+				location = parts.host + (parts.port > 0 ? ":" + String::num_int64(parts.port) : String()) + location;
+			}
+			url = location;
+			continue;
+		}
+
+		if (code == 206) {
+			// Content-Range: bytes 0-0/<total>
+			String content_range = _find_header(response_headers, "Content-Range");
+			int slash = content_range.rfind("/");
+			r_total = slash >= 0 ? content_range.substr(slash + 1).strip_edges().to_int() : -1;
+			r_ranges = r_total > 0;
+		} else if (code == 200) {
+			String content_length = _find_header(response_headers, "Content-Length");
+			r_total = content_length.is_empty() ? -1 : content_length.to_int();
+			r_ranges = false;
+		} else {
+			String message = "HTTP error " + String::num_int64(code);
+			if (code == 404) {
+				message = "File not found (404). The URL may have changed.";
+			} else if (code == 403 || code == 401) {
+				message = "Access denied (" + String::num_int64(code) + "). The file may require authentication.";
+			} else if (code >= 500) {
+				message = "Server error (" + String::num_int64(code) + "). Please try again later.";
+			}
+			_fail(ERR_CANT_ACQUIRE_RESOURCE, message);
+			return false;
+		}
+
+		m_resolved_url = url;
+		return true;
+	}
+
+	_fail(ERR_CANT_ACQUIRE_RESOURCE, "Too many redirects");
+	return false;
+}
+
+// ==================== Workers ====================
+
+int64_t ParallelDownloader::_segment_length(int64_t index) const {
+	int64_t start = index * m_segment_size;
+	return std::min(m_segment_size, m_total_bytes.load() - start);
+}
+
+void ParallelDownloader::_worker() {
+	const int64_t window = static_cast<int64_t>(m_connections) * HASH_WINDOW_PER_CONNECTION;
+	std::vector<uint8_t> buffer;
+	Ref<HTTPClient> client; // kept alive across segments
+
+	while (!m_cancel_requested && m_status == STATUS_DOWNLOADING) {
+		int64_t index = m_next_segment.fetch_add(1);
+		if (index >= m_segment_count) {
+			break;
+		}
+
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			if (m_segment_done[index]) {
+				continue;
+			}
+			// Don't run too far ahead of the hash, out-of-order segments are held in memory
+			m_hash_advanced.wait(lock, [&]() {
+				return index < m_hash_next + window || m_cancel_requested || m_status != STATUS_DOWNLOADING;
+			});
+		}
+		if (m_cancel_requested || m_status != STATUS_DOWNLOADING) {
+			break;
+		}
+
+		bool ok = false;
+		for (int32_t attempt = 0; attempt <= m_max_retries && !m_cancel_requested; attempt++) {
+			if (attempt > 0) {
+				// Back off, but wake up at once on cancel so cancel() never blocks the caller
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_hash_advanced.wait_for(lock, std::chrono::milliseconds(500LL << std::min(attempt - 1, 4)), [&]() {
+					return m_cancel_requested || m_status != STATUS_DOWNLOADING;
+				});
+				if (m_cancel_requested || m_status != STATUS_DOWNLOADING) {
+					break;
+				}
+			}
+			if (_download_segment(index, client, buffer)) {
+				ok = true;
+				break;
+			}
+			client.unref();
+			if (m_status != STATUS_DOWNLOADING) {
+				break;
+			}
+		}
+
+		if (!ok) {
+			if (!m_cancel_requested && m_status == STATUS_DOWNLOADING) {
+				_fail(ERR_CONNECTION_ERROR, "Failed to download bytes " + String::num_int64(index * m_segment_size) + "+ after " + String::num_int64(m_max_retries + 1) + " attempts");
+			}
+			break;
+		}
+
+		_segment_finished(index, std::move(buffer));
+		buffer = std::vector<uint8_t>();
+	}
+}
+
+bool ParallelDownloader::_download_segment(int64_t index, Ref<HTTPClient> &client, std::vector<uint8_t> &r_buffer) {
+	const int64_t start = index * m_segment_size;
+	const int64_t length = _segment_length(index);
+
+	r_buffer.clear();
+	r_buffer.reserve(static_cast<size_t>(length));
+
+	// Progress counts bytes as they arrive, so roll back on failure
+	auto rollback = [&]() {
+		m_downloaded_bytes -= static_cast<int64_t>(r_buffer.size());
+		r_buffer.clear();
+		return false;
+	};
+
+	PackedStringArray headers = m_headers;
+	headers.push_back("Range: bytes=" + String::num_int64(start) + "-" + String::num_int64(start + length - 1));
+
+	if (_open_request(client, m_resolved_url, headers) != OK) {
+		return false;
+	}
+	if (client->get_response_code() != 206) {
+		return false;
+	}
+
+	auto last_data = std::chrono::steady_clock::now();
+	while (client->get_status() == HTTPClient::STATUS_BODY) {
+		if (m_cancel_requested || m_status != STATUS_DOWNLOADING) {
+			return rollback();
+		}
+
+		client->poll();
+		PackedByteArray chunk = client->read_response_body_chunk();
+		if (chunk.is_empty()) {
+			auto idle_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - last_data).count();
+			if (idle_ms >= STALL_TIMEOUT_MS) {
+				return rollback();
+			}
+			sleep_ms(1);
+			continue;
+		}
+		last_data = std::chrono::steady_clock::now();
+
+		const int64_t chunk_size = chunk.size();
+		const int64_t received = static_cast<int64_t>(r_buffer.size());
+		if (received + chunk_size > length) {
+			return rollback();
+		}
+		if (!_write_at(start + received, chunk.ptr(), chunk_size)) {
+			rollback();
+			_fail(ERR_FILE_CANT_WRITE, "Write failed on " + m_target_path);
+			return false;
+		}
+
+		r_buffer.insert(r_buffer.end(), chunk.ptr(), chunk.ptr() + chunk_size);
+		m_downloaded_bytes += chunk_size;
+	}
+
+	if (static_cast<int64_t>(r_buffer.size()) != length) {
+		return rollback();
+	}
+	return true;
+}
+
+bool ParallelDownloader::_download_single() {
+	// Server does not honour ranges: one sequential stream, no resume
+	UtilityFunctions::print("ParallelDownloader: Server does not support ranges, using a single connection");
+
+	if (!_open_target(true)) {
+		_fail(ERR_FILE_CANT_WRITE, "Cannot open target file: " + m_target_path);
+		return false;
+	}
+	int64_t total = m_total_bytes;
+	if (total > 0 && !_preallocate(total)) {
+		_close_target();
+		_fail(ERR_FILE_CANT_WRITE, "Cannot allocate " + String::num_int64(total) + " bytes for " + m_target_path);
+		return false;
+	}
+
+	Ref<HTTPClient> client;
+	if (_open_request(client, m_resolved_url, m_headers) != OK || client->get_response_code() != 200) {
+		_close_target();
+		if (!m_cancel_requested) {
+			_fail(ERR_CONNECTION_ERROR, "Cannot download " + m_url);
+		}
+		return false;
+	}
+
+	int64_t offset = 0;
+	auto last_data = std::chrono::steady_clock::now();
+	while (client->get_status() == HTTPClient::STATUS_BODY && !m_cancel_requested) {
+		client->poll();
+		PackedByteArray chunk = client->read_response_body_chunk();
+		if (chunk.is_empty()) {
+			auto idle_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - last_data).count();
+			if (idle_ms >= STALL_TIMEOUT_MS) {
+				break;
+			}
+			sleep_ms(1);
+			continue;
+		}
+		last_data = std::chrono::steady_clock::now();
+
+		if (!_write_at(offset, chunk.ptr(), chunk.size())) {
+			_close_target();
+			_fail(ERR_FILE_CANT_WRITE, "Write failed on " + m_target_path);
+			return false;
+		}
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_sha.update(chunk.ptr(), static_cast<size_t>(chunk.size()));
+		}
+		offset += chunk.size();
+		m_downloaded_bytes = offset;
+	}
+	const bool flushed = _flush_target();
+	_close_target();
+
+	if (m_cancel_requested) {
+		return false;
+	}
+	// Without a known size only a cleanly finished body counts, never a connection or TLS error
+	bool body_complete = offset == total;
+	if (total <= 0) {
+		const HTTPClient::Status end_status = client->get_status();
+		body_complete = end_status == HTTPClient::STATUS_CONNECTED || end_status == HTTPClient::STATUS_DISCONNECTED;
+	}
+	if (!body_complete) {
+		_fail(ERR_CONNECTION_ERROR, "Connection lost after " + String::num_int64(offset) + " bytes");
+		return false;
+	}
+	if (!flushed) {
+		_fail(ERR_FILE_CANT_WRITE, "Cannot flush " + m_target_path + " to disk");
+		return false;
+	}
+
+	m_total_bytes = offset;
+	return true;
+}
+
+void ParallelDownloader::_segment_finished(int64_t index, std::vector<uint8_t> &&data) {
+	// The segment must be on disk before the sidecar claims it is done
+	if (!_flush_target()) {
+		_fail(ERR_FILE_CANT_WRITE, "Cannot flush " + m_target_path + " to disk");
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_segment_done[index] = 1;
+	m_pending_hash.emplace(index, std::move(data));
+	bool hashed = _advance_hash_locked();
+	_save_progress_locked();
+	lock.unlock();
+
+	if (!hashed) {
+		_fail(ERR_FILE_CANT_READ, "Cannot read back previously downloaded data");
+	}
+}
+
+bool ParallelDownloader::_advance_hash_locked() {
+	bool ok = true;
+
+	while (m_hash_next < m_segment_count) {
+		auto it = m_pending_hash.find(m_hash_next);
+		if (it != m_pending_hash.end()) {
+			m_sha.update(it->second.data(), it->second.size());
+			m_pending_hash.erase(it);
+		} else if (m_segment_done[m_hash_next]) {
+			// Finished in a previous session: read it back from disk once
+			std::vector<uint8_t> data(static_cast<size_t>(_segment_length(m_hash_next)));
+			if (!_read_at(m_hash_next * m_segment_size, data.data(), static_cast<int64_t>(data.size()))) {
+				ok = false;
+				break;
+			}
+			m_sha.update(data.data(), data.size());
+		} else {
+			break;
+		}
+		m_hash_next++;
+	}
+
+	m_hash_advanced.notify_all();
+	return ok;
+}
+
+// ==================== HTTP Helpers ====================
+
+bool ParallelDownloader::_parse_url(const String &url, UrlParts &r_parts) {
+	String scheme;
+	if (url.begins_with("https://")) {
+		scheme = "https://";
+	} else if (url.begins_with("http://")) {
+		scheme = "http://";
+	} else {
+		return false;
+	}
+
+	String rest = url.substr(scheme.length());
+	int slash = rest.find("/");
+	String host_port = slash >= 0 ? rest.substr(0, slash) : rest;
+	r_parts.path = slash >= 0 ? rest.substr(slash) : String("/");
+
+	r_parts.port = -1;
+	int colon = host_port.rfind(":");
+	if (colon >= 0 && !host_port.ends_with("]")) {
+		r_parts.port = static_cast<int32_t>(host_port.substr(colon + 1).to_int());
+		host_port = host_port.substr(0, colon);
+	}
+	if (host_port.is_empty()) {
+		return false;
+	}
+
+	r_parts.host = scheme + host_port;
+	return true;
+}
+
+String ParallelDownloader::_find_header(const PackedStringArray &headers, const String &name) {
+	const String prefix = name.to_lower() + ":";
+	for (int i = 0; i < headers.size(); i++) {
+		if (headers[i].to_lower().begins_with(prefix)) {
+			return headers[i].substr(prefix.length()).strip_edges();
+		}
+	}
+	return String();
+}
+
+Error ParallelDownloader::_open_request(Ref<HTTPClient> &client, const String &url, const PackedStringArray &extra_headers) const {
+	UrlParts parts;
+	if (!_parse_url(url, parts)) {
+		return ERR_INVALID_PARAMETER;
+	}
+
+	auto wait_while = [&](HTTPClient::Status a, HTTPClient::Status b) {
+		auto started = std::chrono::steady_clock::now();
+		while (client->get_status() == a || client->get_status() == b) {
+			if (m_cancel_requested) {
+				return false;
+			}
+			auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started).count();
+			if (elapsed_ms >= STALL_TIMEOUT_MS) {
+				return false;
+			}
+			client->poll();
+			sleep_ms(1);
+		}
+		return true;
+	};
+
+	// Reuse a kept-alive connection when the caller passes one back in
+	if (client.is_null() || client->get_status() != HTTPClient::STATUS_CONNECTED) {
+		client.instantiate();
+		client->set_blocking_mode(false);
+		client->set_read_chunk_size(READ_CHUNK_SIZE);
+
+		Error err = client->connect_to_host(parts.host, parts.port);
+		if (err != OK) {
+			return err;
+		}
+
+		if (!wait_while(HTTPClient::STATUS_RESOLVING, HTTPClient::STATUS_CONNECTING) ||
+				client->get_status() != HTTPClient::STATUS_CONNECTED) {
+			return ERR_CANT_CONNECT;
+		}
+	}
+
+	PackedStringArray headers = extra_headers;
+	if (_find_header(headers, "User-Agent").is_empty()) {
+		headers.push_back(String("User-Agent: ") + USER_AGENT);
+	}
+
+	Error err = client->request(HTTPClient::METHOD_GET, parts.path, headers);
+	if (err != OK) {
+		return err;
+	}
+
+	if (!wait_while(HTTPClient::STATUS_REQUESTING, HTTPClient::STATUS_REQUESTING) || !client->has_response()) {
+		return ERR_CONNECTION_ERROR;
+	}
+
+	return OK;
+}
+
+// ==================== Progress Persistence ====================
+
+String ParallelDownloader::_progress_path() const {
+	return m_target_global + ".progress";
+}
+
+bool ParallelDownloader::_load_progress() {
+	const String path = _progress_path();
+	if (!FileAccess::file_exists(path) || !FileAccess::file_exists(m_part_global)) {
+		return false;
+	}
+
+	// The preallocated file must still be there at full size
+	Ref<FileAccess> target = FileAccess::open(m_part_global, FileAccess::READ);
+	if (target.is_null() || static_cast<int64_t>(target->get_length()) != m_total_bytes) {
+		return false;
+	}
+	target->close();
+
+	Variant parsed = JSON::parse_string(FileAccess::get_file_as_string(path));
+	if (parsed.get_type() != Variant::DICTIONARY) {
+		return false;
+	}
+	Dictionary progress = parsed;
+
+	if (String(progress.get("url", "")) != m_url ||
+			static_cast<int64_t>(progress.get("total_bytes", -1)) != m_total_bytes ||
+			static_cast<int64_t>(progress.get("segment_size", -1)) != m_segment_size) {
+		return false;
+	}
+
+	String done = progress.get("done", "");
+	if (done.length() != m_segment_count) {
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (int64_t i = 0; i < m_segment_count; i++) {
+		m_segment_done[i] = done[i] == '1' ? 1 : 0;
+	}
+
+	// Continue the digest where it stopped; without a usable state every
+	// finished segment is re-read from disk once instead
+	CharString sha_state = String(progress.get("sha_state", "")).utf8();
+	int64_t hash_next = progress.get("hash_next", 0);
+	if (hash_next > 0 && hash_next <= m_segment_count && m_sha.load_state(sha_state.get_data()) &&
+			static_cast<int64_t>(m_sha.get_length()) == hash_next * m_segment_size) {
+		m_hash_next = hash_next;
+	} else {
+		m_sha.reset();
+		m_hash_next = 0;
+	}
+
+	return true;
+}
+
+void ParallelDownloader::_save_progress_locked() const {
+	if (!m_ranges_supported || !m_resume) {
+		return;
+	}
+
+	String done;
+	for (int64_t i = 0; i < m_segment_count; i++) {
+		done += m_segment_done[i] ? "1" : "0";
+	}
+
+	Dictionary progress;
+	progress["url"] = m_url;
+	progress["total_bytes"] = m_total_bytes.load();
+	progress["segment_size"] = m_segment_size;
+	progress["done"] = done;
+	if (m_sha.is_block_aligned()) {
+		progress["hash_next"] = m_hash_next;
+		progress["sha_state"] = String::utf8(m_sha.save_state().c_str());
+	}
+
+	// Written to a temporary file and renamed, so a crash never leaves a torn sidecar
+	if (!write_file_atomic(_progress_path(), JSON::stringify(progress).utf8())) {
+		UtilityFunctions::push_warning("ParallelDownloader: Cannot save progress for ", m_target_path);
+	}
+}
+
+void ParallelDownloader::_remove_progress() const {
+	if (FileAccess::file_exists(_progress_path())) {
+		DirAccess::remove_absolute(_progress_path());
+	}
+}
+
+void ParallelDownloader::_discard_partial() const {
+	if (FileAccess::file_exists(m_part_global)) {
+		DirAccess::remove_absolute(m_part_global);
+	}
+	_remove_progress();
+}
+
+bool ParallelDownloader::_finalize_target() {
+	// Only a verified, flushed download ever appears under the target name
+	if (!replace_file(m_part_global, m_target_global)) {
+		return false;
+	}
+	_remove_progress();
+	return true;
+}
+
+// ==================== Positional File I/O ====================
+
+#ifdef _WIN32
+
+bool ParallelDownloader::_open_target(bool truncate) {
+	_close_target();
+	CharWideString wide_path = m_part_global.replace("/", "\\").wide_string();
+	HANDLE handle = CreateFileW(reinterpret_cast<LPCWSTR>(wide_path.get_data()), GENERIC_READ | GENERIC_WRITE,
+			FILE_SHARE_READ, nullptr, truncate ? CREATE_ALWAYS : OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (handle == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	m_file = reinterpret_cast<intptr_t>(handle);
+	return true;
+}
+
+void ParallelDownloader::_close_target() {
+	if (m_file != -1) {
+		CloseHandle(reinterpret_cast<HANDLE>(m_file));
+		m_file = -1;
+	}
+}
+
+bool ParallelDownloader::_flush_target() {
+	return FlushFileBuffers(reinterpret_cast<HANDLE>(m_file)) != 0;
+}
+
+bool ParallelDownloader::_preallocate(int64_t size) {
+	HANDLE handle = reinterpret_cast<HANDLE>(m_file);
+	LARGE_INTEGER distance;
+	distance.QuadPart = size;
+	return SetFilePointerEx(handle, distance, nullptr, FILE_BEGIN) && SetEndOfFile(handle);
+}
+
+bool ParallelDownloader::_write_at(int64_t offset, const uint8_t *data, int64_t size) {
+	HANDLE handle = reinterpret_cast<HANDLE>(m_file);
+	while (size > 0) {
+		OVERLAPPED overlapped = {};
+		overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFF);
+		overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+		DWORD written = 0;
+		if (!WriteFile(handle, data, static_cast<DWORD>(size), &written, &overlapped) || written == 0) {
+			return false;
+		}
+		data += written;
+		offset += written;
+		size -= written;
+	}
+	return true;
+}
+
+bool ParallelDownloader::_read_at(int64_t offset, uint8_t *data, int64_t size) const {
+	HANDLE handle = reinterpret_cast<HANDLE>(m_file);
+	while (size > 0) {
+		OVERLAPPED overlapped = {};
+		overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFF);
+		overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+		DWORD bytes_read = 0;
+		if (!ReadFile(handle, data, static_cast<DWORD>(size), &bytes_read, &overlapped) || bytes_read == 0) {
+			return false;
+		}
+		data += bytes_read;
+		offset += bytes_read;
+		size -= bytes_read;
+	}
+	return true;
+}
+
+static bool replace_file(const String &from, const String &to) {
+	CharWideString wide_from = from.replace("/", "\\").wide_string();
+	CharWideString wide_to = to.replace("/", "\\").wide_string();
+	return MoveFileExW(reinterpret_cast<LPCWSTR>(wide_from.get_data()), reinterpret_cast<LPCWSTR>(wide_to.get_data()),
+				   MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+}
+
+static bool write_file_atomic(const String &path, const CharString &data) {
+	const String temp_path = path + ".tmp";
+	CharWideString wide_path = temp_path.replace("/", "\\").wide_string();
+	HANDLE handle = CreateFileW(reinterpret_cast<LPCWSTR>(wide_path.get_data()), GENERIC_WRITE, 0, nullptr,
+			CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (handle == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	DWORD written = 0;
+	bool ok = WriteFile(handle, data.get_data(), static_cast<DWORD>(data.length()), &written, nullptr) &&
+			written == static_cast<DWORD>(data.length()) && FlushFileBuffers(handle);
+	CloseHandle(handle);
+	return ok && replace_file(temp_path, path);
+}
+
+#else
+
+bool ParallelDownloader::_open_target(bool truncate) {
+	_close_target();
+	CharString path_utf8 = m_part_global.utf8();
+	int flags = O_RDWR | O_CREAT | O_CLOEXEC | (truncate ? O_TRUNC : 0);
+	int fd = ::open(path_utf8.get_data(), flags, 0644);
+	if (fd < 0) {
+		return false;
+	}
+	m_file = fd;
+	return true;
+}
+
+void ParallelDownloader::_close_target() {
+	if (m_file != -1) {
+		::close(static_cast<int>(m_file));
+		m_file = -1;
+	}
+}
+
+static bool sync_fd(int fd) {
+#ifdef __APPLE__
+	return fsync(fd) == 0;
+#else
+	return fdatasync(fd) == 0;
+#endif
+}
+
+bool ParallelDownloader::_flush_target() {
+	return sync_fd(static_cast<int>(m_file));
+}
+
+bool ParallelDownloader::_preallocate(int64_t size) {
+	int fd = static_cast<int>(m_file);
+	if (ftruncate(fd, size) != 0) {
+		return false;
+	}
+#ifdef __linux__
+	// Reserve the blocks up front so a full disk fails now, not halfway through.
+	// Not every filesystem supports it, the sparse file from ftruncate still works.
+	posix_fallocate(fd, 0, size);
+#endif
+	return true;
+}
+
+bool ParallelDownloader::_write_at(int64_t offset, const uint8_t *data, int64_t size) {
+	int fd = static_cast<int>(m_file);
+	while (size > 0) {
+		ssize_t written = ::pwrite(fd, data, static_cast<size_t>(size), offset);
+		if (written < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return false;
+		}
+		data += written;
+		offset += written;
+		size -= written;
+	}
+	return true;
+}
+
+bool ParallelDownloader::_read_at(int64_t offset, uint8_t *data, int64_t size) const {
+	int fd = static_cast<int>(m_file);
+	while (size > 0) {
+		ssize_t bytes_read = ::pread(fd, data, static_cast<size_t>(size), offset);
+		if (bytes_read < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return false;
+		}
+		if (bytes_read == 0) {
+			return false;
+		}
+		data += bytes_read;
+		offset += bytes_read;
+		size -= bytes_read;
+	}
+	return true;
+}
+
+static bool replace_file(const String &from, const String &to) {
+	return ::rename(from.utf8().get_data(), to.utf8().get_data()) == 0;
+}
+
+static bool write_file_atomic(const String &path, const CharString &data) {
+	const String temp_path = path + ".tmp";
+	int fd = ::open(temp_path.utf8().get_data(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (fd < 0) {
+		return false;
+	}
+	const char *bytes = data.get_data();
+	size_t remaining = static_cast<size_t>(data.length());
+	bool ok = true;
+	while (ok && remaining > 0) {
+		ssize_t written = ::write(fd, bytes, remaining);
+		if (written < 0) {
+			ok = errno == EINTR;
+			continue;
+		}
+		bytes += written;
+		remaining -= static_cast<size_t>(written);
+	}
+	ok = ok && sync_fd(fd);
+	::close(fd);
+	return ok && replace_file(temp_path, path);
+}
+
+#endif
+
+// ==================== Status ====================
+
+ParallelDownloader::Status ParallelDownloader::get_status() const {
+	return static_cast<Status>(m_status.load());
+}
+
+bool ParallelDownloader::is_running() const {
+	return m_status == STATUS_DOWNLOADING;
+}
+
+int64_t ParallelDownloader::get_downloaded_bytes() const {
+	return m_downloaded_bytes;
+}
+
+int64_t ParallelDownloader::get_total_bytes() const {
+	return m_total_bytes;
+}
+
+float ParallelDownloader::get_progress() const {
+	int64_t total = m_total_bytes;
+	if (total <= 0) {
+		return 0.0f;
+	}
+	return std::clamp(static_cast<float>(m_downloaded_bytes.load()) / static_cast<float>(total), 0.0f, 1.0f);
+}
+
+String ParallelDownloader::get_sha256() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return String::utf8(m_sha256_hex.c_str());
+}
+
+Error ParallelDownloader::get_error() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_error;
+}
+
+String ParallelDownloader::get_error_message() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_error_message;
+}
+
+String ParallelDownloader::get_target_path() const {
+	return m_target_path;
+}
+
+} // namespace godot
@@ -0,0 +1,170 @@
+#ifndef PARALLEL_DOWNLOADER_H
+#define PARALLEL_DOWNLOADER_H
+
+#include <godot_cpp/classes/http_client.hpp>
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_string_array.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+#include "sha256.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace godot {
+
+/// ParallelDownloader: Resumable multi-connection HTTP downloader.
+/// Fetches byte ranges over several connections, writes them with positional
+/// I/O into a preallocated file and computes SHA-256 while segments arrive.
+class ParallelDownloader : public RefCounted {
+	GDCLASS(ParallelDownloader, RefCounted);
+
+public:
+	enum Status {
+		STATUS_IDLE,
+		STATUS_DOWNLOADING,
+		STATUS_COMPLETED,
+		STATUS_FAILED,
+		STATUS_CANCELLED,
+	};
+
+private:
+	// Resolved request
+	struct UrlParts {
+		String host; // includes scheme, as expected by HTTPClient
+		int32_t port = -1;
+		String path;
+	};
+
+	// Configuration for the current download
+	String m_url;
+	String m_resolved_url;
+	String m_target_path;
+	String m_target_global;
+	String m_part_global; // data is staged here until verified
+	std::string m_expected_sha256;
+	PackedStringArray m_headers;
+	int32_t m_connections = 4;
+	int64_t m_segment_size = 4 * 1024 * 1024;
+	int32_t m_max_retries = 3;
+	bool m_resume = true;
+
+	// Shared state between worker threads
+	std::atomic<int> m_status{ STATUS_IDLE };
+	std::atomic<bool> m_cancel_requested{ false };
+	std::atomic<int64_t> m_downloaded_bytes{ 0 };
+	std::atomic<int64_t> m_total_bytes{ 0 };
+	std::atomic<int64_t> m_next_segment{ 0 };
+	int64_t m_segment_count = 0;
+	bool m_ranges_supported = false;
+
+	// Target file handle (platform specific, see parallel_downloader.cpp)
+	intptr_t m_file = -1;
+
+	// Segment bookkeeping and in-order hashing (guarded by m_mutex)
+	mutable std::mutex m_mutex;
+	std::condition_variable m_hash_advanced; // also signalled on cancel and failure
+	std::vector<uint8_t> m_segment_done;
+	std::map<int64_t, std::vector<uint8_t>> m_pending_hash;
+	int64_t m_hash_next = 0;
+	Sha256 m_sha;
+	std::string m_sha256_hex;
+	String m_error_message;
+	Error m_error = OK;
+
+	std::thread m_coordinator;
+
+	// Coordinator / workers
+	void _run();
+	void _worker();
+	bool _download_segment(int64_t index, Ref<HTTPClient> &client, std::vector<uint8_t> &r_buffer);
+	bool _download_single();
+	bool _probe(int64_t &r_total, bool &r_ranges);
+	int64_t _segment_length(int64_t index) const;
+	void _segment_finished(int64_t index, std::vector<uint8_t> &&data);
+	bool _advance_hash_locked();
+	void _fail(Error error, const String &message);
+	void _join();
+
+	// HTTP helpers
+	static bool _parse_url(const String &url, UrlParts &r_parts);
+	static String _find_header(const PackedStringArray &headers, const String &name);
+	Error _open_request(Ref<HTTPClient> &client, const String &url, const PackedStringArray &extra_headers) const;
+
+	// Progress persistence
+	String _progress_path() const;
+	bool _load_progress();
+	void _save_progress_locked() const;
+	void _remove_progress() const;
+	void _discard_partial() const;
+	bool _finalize_target();
+
+	// Positional file I/O
+	bool _open_target(bool truncate);
+	void _close_target();
+	bool _flush_target();
+	bool _preallocate(int64_t size);
+	bool _write_at(int64_t offset, const uint8_t *data, int64_t size);
+	bool _read_at(int64_t offset, uint8_t *data, int64_t size) const;
+
+protected:
+	static void _bind_methods();
+
+public:
+	ParallelDownloader();
+	~ParallelDownloader();
+
+	// ==================== Download Control ====================
+
+	/// Start downloading url into path on background threads.
+	/// @param url HTTP(S) URL of the file (redirects are followed)
+	/// @param path Destination file (supports user:// and res://)
+	/// @param options Optional: connections (int), segment_size (int), sha256 (String),
+	///                headers (PackedStringArray), resume (bool), max_retries (int)
+	/// @return OK if the download started, or an error code
+	Error start(const String &url, const String &path, const Dictionary &options = Dictionary());
+
+	/// Stop the download. Partial data and progress are kept for resuming.
+	void cancel();
+
+	/// Block until the download finishes, fails or is cancelled.
+	void wait();
+
+	// ==================== Status ====================
+
+	/// Current state of the download
+	Status get_status() const;
+	bool is_running() const;
+
+	/// Bytes received so far (includes data resumed from a previous session)
+	int64_t get_downloaded_bytes() const;
+
+	/// Size of the remote file, or 0 if unknown
+	int64_t get_total_bytes() const;
+
+	/// Progress from 0.0 to 1.0 (0.0 while the size is unknown)
+	float get_progress() const;
+
+	/// SHA-256 of the downloaded file as lowercase hex (after completion)
+	String get_sha256() const;
+
+	/// Error and message of the last failed download
+	Error get_error() const;
+	String get_error_message() const;
+
+	/// Destination path as passed to start()
+	String get_target_path() const;
+};
+
+} // namespace godot
+
+VARIANT_ENUM_CAST(ParallelDownloader::Status);
+
+#endif // PARALLEL_DOWNLOADER_H
@@ -6,6 +6,8 @@
 #include <godot_cpp/godot.hpp>
 
 #include "llama_interface.h"
+#include "parallel_downloader.h"
+#include "text_chunk_pipeline.h"
 
 using namespace godot;
 
@@ -14,7 +16,10 @@ void initialize_ohmydialog_module(ModuleInitializationLevel p_level) {
         return;
     }
 
+    // TextChunkPipeline first: LlamaInterface methods take it as an argument
+    GDREGISTER_CLASS(TextChunkPipeline);
     GDREGISTER_CLASS(LlamaInterface);
+    GDREGISTER_CLASS(ParallelDownloader);
 }
 
 void uninitialize_ohmydialog_module(ModuleInitializationLevel p_level) {
@@ -0,0 +1,204 @@
+#include "sentence_chunker.h"
+
+namespace godot {
+
+enum PunctKind {
+	PUNCT_NONE,
+	PUNCT_SENTENCE,
+	PUNCT_CLAUSE,
+};
+
+// Byte length of the UTF-8 sequence starting with this lead byte.
+// Stray continuation or invalid bytes count as one so they can't stall the scan.
+static size_t utf8_length(unsigned char lead) {
+	if (lead < 0x80) {
+		return 1;
+	}
+	if ((lead >> 5) == 0x06) {
+		return 2;
+	}
+	if ((lead >> 4) == 0x0E) {
+		return 3;
+	}
+	if ((lead >> 3) == 0x1E) {
+		return 4;
+	}
+	return 1;
+}
+
+static uint32_t utf8_decode(const std::string &text, size_t pos, size_t length) {
+	const unsigned char lead = static_cast<unsigned char>(text[pos]);
+	if (length == 1) {
+		return lead;
+	}
+
+	uint32_t cp = lead & (0xFF >> (length + 1));
+	for (size_t i = 1; i < length; i++) {
+		cp = (cp << 6) | (static_cast<unsigned char>(text[pos + i]) & 0x3F);
+	}
+	return cp;
+}
+
+static PunctKind classify(uint32_t cp) {
+	switch (cp) {
+		case '.':
+		case '!':
+		case '?':
+		case 0x2026: // …
+		case 0x3002: // 。
+		case 0xFF01: // ！
+		case 0xFF1F: // ？
+			return PUNCT_SENTENCE;
+		case ',':
+		case ';':
+		case ':':
+		case 0x2014: // —
+		case 0x3001: // 、
+		case 0xFF0C: // ，
+		case 0xFF1A: // ：
+		case 0xFF1B: // ；
+			return PUNCT_CLAUSE;
+		default:
+			return PUNCT_NONE;
+	}
+}
+
+// Closing quotes and brackets stay with the sentence they end
+static bool is_closer(uint32_t cp) {
+	switch (cp) {
+		case '"':
+		case '\'':
+		case ')':
+		case ']':
+		case '}':
+		case 0x00BB: // »
+		case 0x2019: // ’
+		case 0x201D: // ”
+		case 0x300D: // 」
+		case 0x300F: // 』
+		case 0xFF09: // ）
+			return true;
+		default:
+			return false;
+	}
+}
+
+// CJK punctuation ends a sentence without a following space
+static bool is_fullwidth(uint32_t cp) {
+	return (cp >= 0x3000 && cp <= 0x303F) || (cp >= 0xFF00 && cp <= 0xFFEF);
+}
+
+static bool is_space(char c) {
+	return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+void SentenceChunker::feed(const char *data, size_t size, std::vector<std::string> &r_chunks) {
+	m_pending.append(data, size);
+
+	size_t cut = 0;
+	size_t next = 0;
+	while (_find_boundary(cut, next)) {
+		_emit(m_pending.substr(0, cut), r_chunks);
+
+		// Whitespace between chunks belongs to neither
+		while (next < m_pending.size() && is_space(m_pending[next])) {
+			next++;
+		}
+		m_pending.erase(0, next);
+	}
+}
+
+void SentenceChunker::flush(std::vector<std::string> &r_chunks) {
+	// Drop a code point left incomplete by the end of the stream
+	size_t end = m_pending.size();
+	size_t lead = end;
+	while (lead > 0 && end - lead < 4) {
+		lead--;
+		if ((static_cast<unsigned char>(m_pending[lead]) & 0xC0) != 0x80) {
+			if (lead + utf8_length(static_cast<unsigned char>(m_pending[lead])) > end) {
+				m_pending.resize(lead);
+			}
+			break;
+		}
+	}
+
+	_emit(m_pending, r_chunks);
+	m_pending.clear();
+}
+
+bool SentenceChunker::_find_boundary(size_t &r_cut, size_t &r_next) const {
+	const size_t size = m_pending.size();
+	int32_t chars = 0;
+	size_t i = 0;
+
+	while (i < size) {
+		const size_t length = utf8_length(static_cast<unsigned char>(m_pending[i]));
+		if (i + length > size) {
+			return false; // Incomplete code point, wait for more bytes
+		}
+
+		const uint32_t cp = utf8_decode(m_pending, i, length);
+		chars++;
+
+		if (cp == '\n') {
+			r_cut = i;
+			r_next = i + 1;
+			return true;
+		}
+
+		const PunctKind kind = classify(cp);
+		if (kind == PUNCT_SENTENCE || (kind == PUNCT_CLAUSE && m_mode == MODE_CLAUSE)) {
+			bool fullwidth = is_fullwidth(cp);
+			size_t j = i + length;
+
+			// Absorb runs like "?!" or "..." and any closing quotes/brackets
+			while (j < size) {
+				const size_t next_length = utf8_length(static_cast<unsigned char>(m_pending[j]));
+				if (j + next_length > size) {
+					return false;
+				}
+				const uint32_t next = utf8_decode(m_pending, j, next_length);
+				if (classify(next) == PUNCT_NONE && !is_closer(next)) {
+					break;
+				}
+				fullwidth = fullwidth || is_fullwidth(next);
+				j += next_length;
+				chars++;
+			}
+
+			// Need to see what follows: "3.14" or "e.g" must not be cut
+			if (j >= size) {
+				return false;
+			}
+
+			if ((fullwidth || is_space(m_pending[j])) && chars >= m_min_length) {
+				r_cut = j;
+				r_next = j;
+				return true;
+			}
+
+			i = j;
+			continue;
+		}
+
+		i += length;
+	}
+
+	return false;
+}
+
+void SentenceChunker::_emit(const std::string &text, std::vector<std::string> &r_chunks) {
+	size_t begin = 0;
+	size_t end = text.size();
+	while (begin < end && is_space(text[begin])) {
+		begin++;
+	}
+	while (end > begin && is_space(text[end - 1])) {
+		end--;
+	}
+	if (end > begin) {
+		r_chunks.push_back(text.substr(begin, end - begin));
+	}
+}
+
+} // namespace godot
@@ -0,0 +1,53 @@
+#ifndef SENTENCE_CHUNKER_H
+#define SENTENCE_CHUNKER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace godot {
+
+/// SentenceChunker: Splits streamed UTF-8 text into sentences or clauses.
+/// Bytes may arrive in arbitrary pieces (e.g. one token at a time, with
+/// code points split across pieces); cuts only ever happen on complete
+/// code points, so every emitted chunk is valid UTF-8.
+class SentenceChunker {
+public:
+	enum Mode {
+		MODE_SENTENCE, // cut after . ! ? … 。！？ and newlines
+		MODE_CLAUSE, // additionally cut after , ; : — 、，；：
+	};
+
+	/// Set the split granularity.
+	void set_mode(Mode mode) { m_mode = mode; }
+	Mode get_mode() const { return m_mode; }
+
+	/// Chunks shorter than this many characters are merged into the next one.
+	void set_min_length(int32_t length) { m_min_length = length > 0 ? length : 0; }
+	int32_t get_min_length() const { return m_min_length; }
+
+	/// Append bytes and move any completed chunks to r_chunks.
+	void feed(const char *data, size_t size, std::vector<std::string> &r_chunks);
+
+	/// Emit whatever is left as a final chunk (end of stream).
+	void flush(std::vector<std::string> &r_chunks);
+
+	/// Drop buffered text.
+	void reset() { m_pending.clear(); }
+
+	/// Bytes buffered waiting for a boundary.
+	size_t get_pending_size() const { return m_pending.size(); }
+
+private:
+	Mode m_mode = MODE_SENTENCE;
+	int32_t m_min_length = 8;
+	std::string m_pending;
+
+	bool _find_boundary(size_t &r_cut, size_t &r_next) const;
+	static void _emit(const std::string &text, std::vector<std::string> &r_chunks);
+};
+
+} // namespace godot
+
+#endif // SENTENCE_CHUNKER_H
@@ -0,0 +1,210 @@
+#include "sha256.h"
+
+#include <cstring>
+
+namespace godot {
+
+static const uint32_t K[64] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static inline uint32_t rotr(uint32_t x, uint32_t n) {
+	return (x >> n) | (x << (32 - n));
+}
+
+static const char HEX_DIGITS[] = "0123456789abcdef";
+
+static int hex_value(char c) {
+	if (c >= '0' && c <= '9') {
+		return c - '0';
+	}
+	if (c >= 'a' && c <= 'f') {
+		return c - 'a' + 10;
+	}
+	if (c >= 'A' && c <= 'F') {
+		return c - 'A' + 10;
+	}
+	return -1;
+}
+
+Sha256::Sha256() {
+	reset();
+}
+
+void Sha256::reset() {
+	m_h[0] = 0x6a09e667;
+	m_h[1] = 0xbb67ae85;
+	m_h[2] = 0x3c6ef372;
+	m_h[3] = 0xa54ff53a;
+	m_h[4] = 0x510e527f;
+	m_h[5] = 0x9b05688c;
+	m_h[6] = 0x1f83d9ab;
+	m_h[7] = 0x5be0cd19;
+	m_buffer_len = 0;
+	m_length = 0;
+}
+
+void Sha256::_transform(const uint8_t *block) {
+	uint32_t w[64];
+	for (int i = 0; i < 16; i++) {
+		w[i] = (static_cast<uint32_t>(block[i * 4]) << 24) |
+				(static_cast<uint32_t>(block[i * 4 + 1]) << 16) |
+				(static_cast<uint32_t>(block[i * 4 + 2]) << 8) |
+				static_cast<uint32_t>(block[i * 4 + 3]);
+	}
+	for (int i = 16; i < 64; i++) {
+		uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+		uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+		w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+	}
+
+	uint32_t a = m_h[0], b = m_h[1], c = m_h[2], d = m_h[3];
+	uint32_t e = m_h[4], f = m_h[5], g = m_h[6], h = m_h[7];
+
+	for (int i = 0; i < 64; i++) {
+		uint32_t s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+		uint32_t ch = (e & f) ^ (~e & g);
+		uint32_t t1 = h + s1 + ch + K[i] + w[i];
+		uint32_t s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+		uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+		uint32_t t2 = s0 + maj;
+
+		h = g;
+		g = f;
+		f = e;
+		e = d + t1;
+		d = c;
+		c = b;
+		b = a;
+		a = t1 + t2;
+	}
+
+	m_h[0] += a;
+	m_h[1] += b;
+	m_h[2] += c;
+	m_h[3] += d;
+	m_h[4] += e;
+	m_h[5] += f;
+	m_h[6] += g;
+	m_h[7] += h;
+}
+
+void Sha256::update(const uint8_t *data, size_t size) {
+	m_length += size;
+
+	// Complete a previously buffered partial block first
+	if (m_buffer_len > 0) {
+		size_t take = BLOCK_SIZE - m_buffer_len;
+		if (take > size) {
+			take = size;
+		}
+		memcpy(m_buffer + m_buffer_len, data, take);
+		m_buffer_len += take;
+		data += take;
+		size -= take;
+
+		if (m_buffer_len < BLOCK_SIZE) {
+			return;
+		}
+		_transform(m_buffer);
+		m_buffer_len = 0;
+	}
+
+	// Hash full blocks straight from the input
+	while (size >= BLOCK_SIZE) {
+		_transform(data);
+		data += BLOCK_SIZE;
+		size -= BLOCK_SIZE;
+	}
+
+	if (size > 0) {
+		memcpy(m_buffer, data, size);
+		m_buffer_len = size;
+	}
+}
+
+std::array<uint8_t, Sha256::DIGEST_SIZE> Sha256::finalize() {
+	const uint64_t bit_length = m_length * 8;
+
+	// Padding: 0x80, zeros, then the 64-bit big-endian message length
+	uint8_t padding[BLOCK_SIZE * 2] = { 0x80 };
+	size_t pad_len = (m_buffer_len < 56) ? (56 - m_buffer_len) : (120 - m_buffer_len);
+	for (int i = 0; i < 8; i++) {
+		padding[pad_len + i] = static_cast<uint8_t>(bit_length >> (56 - i * 8));
+	}
+	update(padding, pad_len + 8);
+
+	std::array<uint8_t, DIGEST_SIZE> digest;
+	for (int i = 0; i < 8; i++) {
+		digest[i * 4] = static_cast<uint8_t>(m_h[i] >> 24);
+		digest[i * 4 + 1] = static_cast<uint8_t>(m_h[i] >> 16);
+		digest[i * 4 + 2] = static_cast<uint8_t>(m_h[i] >> 8);
+		digest[i * 4 + 3] = static_cast<uint8_t>(m_h[i]);
+	}
+	return digest;
+}
+
+std::string Sha256::finalize_hex() {
+	std::array<uint8_t, DIGEST_SIZE> digest = finalize();
+	std::string hex;
+	hex.reserve(DIGEST_SIZE * 2);
+	for (uint8_t byte : digest) {
+		hex += HEX_DIGITS[byte >> 4];
+		hex += HEX_DIGITS[byte & 0x0f];
+	}
+	return hex;
+}
+
+std::string Sha256::save_state() const {
+	// Layout: 8 state words followed by the byte length, all as big-endian hex
+	std::string state;
+	state.reserve(8 * 8 + 16);
+	for (int i = 0; i < 8; i++) {
+		for (int shift = 28; shift >= 0; shift -= 4) {
+			state += HEX_DIGITS[(m_h[i] >> shift) & 0x0f];
+		}
+	}
+	for (int shift = 60; shift >= 0; shift -= 4) {
+		state += HEX_DIGITS[(m_length >> shift) & 0x0f];
+	}
+	return state;
+}
+
+bool Sha256::load_state(const std::string &state) {
+	if (state.size() != 8 * 8 + 16) {
+		return false;
+	}
+
+	uint32_t h[8] = {};
+	uint64_t length = 0;
+	for (size_t i = 0; i < state.size(); i++) {
+		int value = hex_value(state[i]);
+		if (value < 0) {
+			return false;
+		}
+		if (i < 64) {
+			h[i / 8] = (h[i / 8] << 4) | static_cast<uint32_t>(value);
+		} else {
+			length = (length << 4) | static_cast<uint64_t>(value);
+		}
+	}
+
+	// Only block-aligned states can be resumed
+	if (length % BLOCK_SIZE != 0) {
+		return false;
+	}
+
+	memcpy(m_h, h, sizeof(m_h));
+	m_length = length;
+	m_buffer_len = 0;
+	return true;
+}
+
+} // namespace godot
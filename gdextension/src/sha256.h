@@ -0,0 +1,56 @@
+#ifndef SHA256_H
+#define SHA256_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace godot {
+
+/// Sha256: Incremental SHA-256 (FIPS 180-4).
+/// Unlike HashingContext, the running state can be saved and restored on a
+/// block boundary, which lets resumed downloads continue the same digest.
+class Sha256 {
+public:
+	static constexpr size_t BLOCK_SIZE = 64;
+	static constexpr size_t DIGEST_SIZE = 32;
+
+	Sha256();
+
+	/// Reset to the initial state.
+	void reset();
+
+	/// Feed more data into the digest.
+	void update(const uint8_t *data, size_t size);
+
+	/// Finish the digest. The object must be reset before reuse.
+	std::array<uint8_t, DIGEST_SIZE> finalize();
+
+	/// Finish the digest and return it as lowercase hex.
+	std::string finalize_hex();
+
+	/// Number of bytes hashed so far.
+	uint64_t get_length() const { return m_length; }
+
+	/// Returns true when no partial block is buffered (state can be saved).
+	bool is_block_aligned() const { return m_buffer_len == 0; }
+
+	/// Serialize the running state as hex (only valid when block aligned).
+	std::string save_state() const;
+
+	/// Restore a state produced by save_state(). Returns false if malformed.
+	bool load_state(const std::string &state);
+
+private:
+	uint32_t m_h[8];
+	uint8_t m_buffer[BLOCK_SIZE];
+	size_t m_buffer_len = 0;
+	uint64_t m_length = 0;
+
+	void _transform(const uint8_t *block);
+};
+
+} // namespace godot
+
+#endif // SHA256_H
@@ -0,0 +1,75 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace godot {
+
+/// SpscQueue: Bounded lock-free single-producer / single-consumer ring buffer.
+/// push() must only be called from one thread and pop() from one (other) thread.
+template <typename T>
+class SpscQueue {
+public:
+	/// @param capacity Number of slots, rounded up to a power of two
+	explicit SpscQueue(size_t capacity) {
+		size_t size = 1;
+		while (size < capacity) {
+			size <<= 1;
+		}
+		m_slots.resize(size);
+		m_mask = size - 1;
+	}
+
+	SpscQueue(const SpscQueue &) = delete;
+	SpscQueue &operator=(const SpscQueue &) = delete;
+
+	/// Producer side. Returns false (and leaves value untouched) when full.
+	bool push(T &&value) {
+		const size_t tail = m_tail.load(std::memory_order_relaxed);
+		if (tail - m_head.load(std::memory_order_acquire) > m_mask) {
+			return false;
+		}
+		m_slots[tail & m_mask] = std::move(value);
+		m_tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	/// Consumer side. Returns false when empty.
+	bool pop(T &r_value) {
+		const size_t head = m_head.load(std::memory_order_relaxed);
+		if (head == m_tail.load(std::memory_order_acquire)) {
+			return false;
+		}
+		r_value = std::move(m_slots[head & m_mask]);
+		m_head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	/// Approximate number of queued items (exact when called from either endpoint while the other is idle).
+	size_t size() const {
+		return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+	}
+
+	bool is_empty() const {
+		return size() == 0;
+	}
+
+	size_t capacity() const {
+		return m_mask + 1;
+	}
+
+private:
+	std::vector<T> m_slots;
+	size_t m_mask = 0;
+
+	// Head and tail live on separate cache lines so producer and consumer don't false-share
+	alignas(64) std::atomic<size_t> m_head{ 0 };
+	alignas(64) std::atomic<size_t> m_tail{ 0 };
+};
+
+} // namespace godot
+
+#endif // SPSC_QUEUE_H
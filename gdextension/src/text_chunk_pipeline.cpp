@@ -0,0 +1,235 @@
+#include "text_chunk_pipeline.h"
+
+#include <godot_cpp/core/class_db.hpp>
+
+namespace godot {
+
+TextChunkPipeline::TextChunkPipeline() {
+}
+
+TextChunkPipeline::~TextChunkPipeline() {
+}
+
+void TextChunkPipeline::_bind_methods() {
+	// Producer
+	ClassDB::bind_method(D_METHOD("begin_stream"), &TextChunkPipeline::begin_stream);
+	ClassDB::bind_method(D_METHOD("end_stream"), &TextChunkPipeline::end_stream);
+	ClassDB::bind_method(D_METHOD("feed", "text"), &TextChunkPipeline::feed);
+	ClassDB::bind_method(D_METHOD("feed_utf8", "bytes"), &TextChunkPipeline::feed_utf8);
+
+	// Consumer
+	ClassDB::bind_method(D_METHOD("dispatch", "max_chunks"), &TextChunkPipeline::dispatch, DEFVAL(0));
+	ClassDB::bind_method(D_METHOD("get_pending_count"), &TextChunkPipeline::get_pending_count);
+	ClassDB::bind_method(D_METHOD("add_consumer", "consumer"), &TextChunkPipeline::add_consumer);
+	ClassDB::bind_method(D_METHOD("remove_consumer", "consumer"), &TextChunkPipeline::remove_consumer);
+	ClassDB::bind_method(D_METHOD("clear_consumers"), &TextChunkPipeline::clear_consumers);
+	ClassDB::bind_method(D_METHOD("get_consumer_count"), &TextChunkPipeline::get_consumer_count);
+
+	// Settings
+	ClassDB::bind_method(D_METHOD("set_split_mode", "mode"), &TextChunkPipeline::set_split_mode);
+	ClassDB::bind_method(D_METHOD("get_split_mode"), &TextChunkPipeline::get_split_mode);
+	ClassDB::bind_method(D_METHOD("set_min_chunk_length", "length"), &TextChunkPipeline::set_min_chunk_length);
+	ClassDB::bind_method(D_METHOD("get_min_chunk_length"), &TextChunkPipeline::get_min_chunk_length);
+	ClassDB::bind_method(D_METHOD("set_dispatch_immediately", "enabled"), &TextChunkPipeline::set_dispatch_immediately);
+	ClassDB::bind_method(D_METHOD("get_dispatch_immediately"), &TextChunkPipeline::get_dispatch_immediately);
+
+	// Signals
+	ADD_SIGNAL(MethodInfo("stream_finished", PropertyInfo(Variant::INT, "chunk_count")));
+
+	// Properties
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "split_mode", PROPERTY_HINT_ENUM, "Sentence,Clause"), "set_split_mode", "get_split_mode");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "min_chunk_length", PROPERTY_HINT_RANGE, "0,256,1"), "set_min_chunk_length", "get_min_chunk_length");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "dispatch_immediately"), "set_dispatch_immediately", "get_dispatch_immediately");
+
+	BIND_ENUM_CONSTANT(SPLIT_SENTENCE);
+	BIND_ENUM_CONSTANT(SPLIT_CLAUSE);
+}
+
+// ==================== Producer ====================
+
+void TextChunkPipeline::begin_stream() {
+	m_chunker.reset();
+	m_next_index = 0;
+}
+
+void TextChunkPipeline::push_utf8(const char *data, size_t size) {
+	m_scratch.clear();
+	m_chunker.feed(data, size, m_scratch);
+	_produce(m_scratch, false);
+}
+
+void TextChunkPipeline::end_stream() {
+	m_scratch.clear();
+	m_chunker.flush(m_scratch);
+	_produce(m_scratch, true);
+}
+
+void TextChunkPipeline::feed(const String &text) {
+	CharString utf8 = text.utf8();
+	push_utf8(utf8.get_data(), static_cast<size_t>(utf8.length()));
+}
+
+void TextChunkPipeline::feed_utf8(const PackedByteArray &bytes) {
+	push_utf8(reinterpret_cast<const char *>(bytes.ptr()), static_cast<size_t>(bytes.size()));
+}
+
+void TextChunkPipeline::_produce(std::vector<std::string> &chunks, bool end_of_stream) {
+	for (std::string &text : chunks) {
+		Chunk chunk;
+		chunk.text = std::move(text);
+		chunk.index = m_next_index++;
+		_publish(std::move(chunk));
+	}
+
+	if (end_of_stream) {
+		Chunk marker;
+		marker.index = m_next_index;
+		marker.end_of_stream = true;
+		_publish(std::move(marker));
+		m_next_index = 0;
+	}
+}
+
+void TextChunkPipeline::_publish(Chunk &&chunk) {
+	if (m_dispatch_immediately) {
+		_deliver(chunk);
+		return;
+	}
+
+	// Fast path: lock-free queue, as long as nothing is waiting in the overflow
+	if (!m_has_overflow.load(std::memory_order_acquire) && m_queue.push(std::move(chunk))) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(m_overflow_mutex);
+	if (m_overflow.empty() && m_queue.push(std::move(chunk))) {
+		return;
+	}
+	m_overflow.push_back(std::move(chunk));
+	m_has_overflow.store(true, std::memory_order_release);
+}
+
+// ==================== Consumer ====================
+
+bool TextChunkPipeline::_pop(Chunk &r_chunk) {
+	if (m_queue.pop(r_chunk)) {
+		return true;
+	}
+	if (!m_has_overflow.load(std::memory_order_acquire)) {
+		return false;
+	}
+
+	// Queue drained: overflow holds the next chunks in order
+	std::lock_guard<std::mutex> lock(m_overflow_mutex);
+	if (m_overflow.empty()) {
+		return false;
+	}
+	r_chunk = std::move(m_overflow.front());
+	m_overflow.pop_front();
+	if (m_overflow.empty()) {
+		m_has_overflow.store(false, std::memory_order_release);
+	}
+	return true;
+}
+
+void TextChunkPipeline::_deliver(const Chunk &chunk) {
+	if (chunk.end_of_stream) {
+		emit_signal("stream_finished", chunk.index);
+		return;
+	}
+
+	// Copy so consumers may add/remove consumers while being called
+	std::vector<Callable> consumers;
+	{
+		std::lock_guard<std::mutex> lock(m_consumers_mutex);
+		consumers = m_consumers;
+	}
+
+	const String text = String::utf8(chunk.text.c_str(), static_cast<int>(chunk.text.size()));
+	for (const Callable &consumer : consumers) {
+		if (consumer.is_valid()) {
+			consumer.call(text, chunk.index);
+		}
+	}
+}
+
+int32_t TextChunkPipeline::dispatch(int32_t max_chunks) {
+	int32_t delivered = 0;
+	Chunk chunk;
+
+	while ((max_chunks <= 0 || delivered < max_chunks) && _pop(chunk)) {
+		_deliver(chunk);
+		if (!chunk.end_of_stream) {
+			delivered++;
+		}
+	}
+
+	return delivered;
+}
+
+int32_t TextChunkPipeline::get_pending_count() const {
+	size_t pending = m_queue.size();
+	if (m_has_overflow.load(std::memory_order_acquire)) {
+		std::lock_guard<std::mutex> lock(m_overflow_mutex);
+		pending += m_overflow.size();
+	}
+	return static_cast<int32_t>(pending);
+}
+
+void TextChunkPipeline::add_consumer(const Callable &consumer) {
+	std::lock_guard<std::mutex> lock(m_consumers_mutex);
+	for (const Callable &existing : m_consumers) {
+		if (existing == consumer) {
+			return;
+		}
+	}
+	m_consumers.push_back(consumer);
+}
+
+void TextChunkPipeline::remove_consumer(const Callable &consumer) {
+	std::lock_guard<std::mutex> lock(m_consumers_mutex);
+	for (auto it = m_consumers.begin(); it != m_consumers.end(); ++it) {
+		if (*it == consumer) {
+			m_consumers.erase(it);
+			return;
+		}
+	}
+}
+
+void TextChunkPipeline::clear_consumers() {
+	std::lock_guard<std::mutex> lock(m_consumers_mutex);
+	m_consumers.clear();
+}
+
+int32_t TextChunkPipeline::get_consumer_count() const {
+	std::lock_guard<std::mutex> lock(m_consumers_mutex);
+	return static_cast<int32_t>(m_consumers.size());
+}
+
+// ==================== Settings ====================
+
+void TextChunkPipeline::set_split_mode(SplitMode mode) {
+	m_chunker.set_mode(static_cast<SentenceChunker::Mode>(mode));
+}
+
+TextChunkPipeline::SplitMode TextChunkPipeline::get_split_mode() const {
+	return static_cast<SplitMode>(m_chunker.get_mode());
+}
+
+void TextChunkPipeline::set_min_chunk_length(int32_t length) {
+	m_chunker.set_min_length(length);
+}
+
+int32_t TextChunkPipeline::get_min_chunk_length() const {
+	return m_chunker.get_min_length();
+}
+
+void TextChunkPipeline::set_dispatch_immediately(bool enabled) {
+	m_dispatch_immediately = enabled;
+}
+
+bool TextChunkPipeline::get_dispatch_immediately() const {
+	return m_dispatch_immediately;
+}
+
+} // namespace godot
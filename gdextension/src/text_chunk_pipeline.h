@@ -0,0 +1,121 @@
+#ifndef TEXT_CHUNK_PIPELINE_H
+#define TEXT_CHUNK_PIPELINE_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/callable.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+#include "sentence_chunker.h"
+#include "spsc_queue.h"
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace godot {
+
+/// TextChunkPipeline: Streams generated text to downstream consumers in
+/// sentence or clause sized chunks (TTS, translation, subtitles...).
+/// The generation thread produces into a lock-free queue; consumers run
+/// on whichever thread calls dispatch(), or inline when dispatch_immediately is set.
+class TextChunkPipeline : public RefCounted {
+	GDCLASS(TextChunkPipeline, RefCounted);
+
+public:
+	enum SplitMode {
+		SPLIT_SENTENCE = SentenceChunker::MODE_SENTENCE,
+		SPLIT_CLAUSE = SentenceChunker::MODE_CLAUSE,
+	};
+
+private:
+	struct Chunk {
+		std::string text;
+		int32_t index = 0;
+		bool end_of_stream = false;
+	};
+
+	static constexpr size_t QUEUE_CAPACITY = 256;
+
+	// Producer side (generation thread)
+	SentenceChunker m_chunker;
+	int32_t m_next_index = 0;
+	std::vector<std::string> m_scratch;
+
+	// Hand-off between producer and consumer. The queue is the lock-free fast
+	// path; the overflow list only fills up when nobody has dispatched for a while.
+	SpscQueue<Chunk> m_queue{ QUEUE_CAPACITY };
+	mutable std::mutex m_overflow_mutex;
+	std::deque<Chunk> m_overflow;
+	std::atomic<bool> m_has_overflow{ false };
+	std::atomic<bool> m_dispatch_immediately{ false };
+
+	// Registered consumers (guarded by m_consumers_mutex)
+	mutable std::mutex m_consumers_mutex;
+	std::vector<Callable> m_consumers;
+
+	void _produce(std::vector<std::string> &chunks, bool end_of_stream);
+	void _publish(Chunk &&chunk);
+	bool _pop(Chunk &r_chunk);
+	void _deliver(const Chunk &chunk);
+
+protected:
+	static void _bind_methods();
+
+public:
+	TextChunkPipeline();
+	~TextChunkPipeline();
+
+	// ==================== Producer ====================
+
+	/// Start a new stream: drop partial text and restart chunk numbering.
+	void begin_stream();
+
+	/// Feed raw UTF-8 bytes (may split code points across calls).
+	void push_utf8(const char *data, size_t size);
+
+	/// Flush the remaining text as the last chunk and mark the end of stream.
+	void end_stream();
+
+	/// GDScript helpers for feeding text from other sources
+	void feed(const String &text);
+	void feed_utf8(const PackedByteArray &bytes);
+
+	// ==================== Consumer ====================
+
+	/// Deliver queued chunks to all consumers.
+	/// @param max_chunks Stop after this many chunks (0 = all queued)
+	/// @return Number of chunks delivered
+	int32_t dispatch(int32_t max_chunks = 0);
+
+	/// Number of chunks waiting for dispatch()
+	int32_t get_pending_count() const;
+
+	/// Register a consumer called as consumer(text: String, index: int)
+	void add_consumer(const Callable &consumer);
+	void remove_consumer(const Callable &consumer);
+	void clear_consumers();
+	int32_t get_consumer_count() const;
+
+	// ==================== Settings ====================
+
+	/// Split granularity (sentences or clauses)
+	void set_split_mode(SplitMode mode);
+	SplitMode get_split_mode() const;
+
+	/// Chunks shorter than this many characters are merged into the next one
+	void set_min_chunk_length(int32_t length);
+	int32_t get_min_chunk_length() const;
+
+	/// Call consumers directly on the producing thread instead of queueing
+	void set_dispatch_immediately(bool enabled);
+	bool get_dispatch_immediately() const;
+};
+
+} // namespace godot
+
+VARIANT_ENUM_CAST(TextChunkPipeline::SplitMode);
+
+#endif // TEXT_CHUNK_PIPELINE_H
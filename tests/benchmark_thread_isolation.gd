@@ -0,0 +1,208 @@
+## Benchmark: jitter de frame time vs tokens/segundo según la configuración de hilos
+## Ejecutar desde editor: Abrir tests/benchmark_thread_isolation.tscn y presionar F6
+## Ejecutar headless: godot --headless --path "." res://tests/benchmark_thread_isolation.tscn
+extends Node
+
+
+## Si true, cierra Godot al terminar (para CI/headless)
+@export var auto_quit: bool = false
+
+## Tokens a generar en cada configuración
+@export var max_tokens: int = 128
+
+## FPS objetivo durante la medición
+@export var target_fps: int = 60
+
+## Trabajo simulado por frame en ms (representa la lógica del juego)
+@export var simulated_frame_work_ms: float = 4.0
+
+## Segundos de medición sin inferencia (línea base)
+@export var idle_seconds: float = 3.0
+
+const PROMPT = "Write a short story about a knight who finds a dragon egg in the mountains."
+
+var _llama: LlamaInterface
+var _frame_times := PackedFloat32Array()
+var _last_ticks: int = 0
+var _measuring: bool = false
+var _results: Array[Dictionary] = []
+
+
+func _ready() -> void:
+	# Detectar si estamos en modo headless
+	if DisplayServer.get_name() == "headless":
+		auto_quit = true
+
+	print("\n" + "=".repeat(60))
+	print("  LlamaInterface - Benchmark de aislamiento de hilos")
+	print("=".repeat(60) + "\n")
+
+	Engine.max_fps = target_fps
+	await run_benchmark()
+
+	if auto_quit:
+		get_tree().quit(0)
+
+
+func _process(_delta: float) -> void:
+	# Medir con ticks reales: el delta de Godot puede estar suavizado
+	var now = Time.get_ticks_usec()
+	if _measuring and _last_ticks > 0:
+		var frame_ms = (now - _last_ticks) / 1000.0
+		_frame_times.append(frame_ms)
+		if _llama != null and _llama.adaptive_threads:
+			_llama.report_frame_time(frame_ms)
+	_last_ticks = now
+
+	_simulate_game_work(simulated_frame_work_ms)
+
+
+func run_benchmark() -> void:
+	var model_path = _find_model()
+	if model_path.is_empty():
+		print("  ⊘ SKIPPED: No hay modelo .gguf en res://models/")
+		return
+
+	print("  Modelo: %s" % model_path)
+	print("  CPUs: %d | Objetivo: %d FPS | Trabajo simulado: %.1f ms/frame\n" % [
+		OS.get_processor_count(), target_fps, simulated_frame_work_ms])
+
+	# Línea base sin inferencia
+	_begin_measure()
+	await get_tree().create_timer(idle_seconds).timeout
+	_end_measure("Sin inferencia", {})
+
+	for config in _get_configs():
+		await _run_config(model_path, config)
+
+	_print_results()
+
+
+func _get_configs() -> Array[Dictionary]:
+	var cpus = OS.get_processor_count()
+	var reserve = clampi(cpus / 4, 1, 2) if cpus > 1 else 0
+	var configs: Array[Dictionary] = [
+		{"name": "Todos los cores", "params": {"n_threads": cpus}},
+		{"name": "Reservar %d core(s)" % reserve, "params": {"reserved_cores": reserve}},
+		{"name": "Adaptativo", "params": {"n_threads": cpus}, "adaptive": true},
+		{"name": "Reservar + adaptativo", "params": {"reserved_cores": reserve}, "adaptive": true},
+	]
+
+	# Afinidad y prioridad solo están soportadas en Linux
+	if OS.get_name() == "Linux":
+		configs.insert(2, {
+			"name": "Reservar + pin + nice 10",
+			"params": {"reserved_cores": reserve, "pin_threads": true, "thread_nice": 10}
+		})
+
+	return configs
+
+
+func _run_config(model_path: String, config: Dictionary) -> void:
+	_llama = LlamaInterface.new()
+	var params: Dictionary = config["params"].duplicate()
+	params["n_ctx"] = 1024
+	var err = _llama.load_model(model_path, params)
+	if err != OK:
+		print("  ⊘ %s: error cargando modelo (%d)" % [config["name"], err])
+		_llama = null
+		return
+
+	_llama.max_tokens = max_tokens
+	_llama.temperature = 0.0
+	_llama.frame_budget_ms = 1000.0 / target_fps * 1.2
+	_llama.adaptive_threads = config.get("adaptive", false)
+
+	# generate() bloquea: correrlo en un Thread para seguir midiendo frames
+	var thread = Thread.new()
+	_begin_measure()
+	thread.start(_llama.generate.bind(PROMPT))
+	while thread.is_alive():
+		await get_tree().process_frame
+	thread.wait_to_finish()
+
+	_end_measure(config["name"], _llama.get_generation_stats())
+	_llama.unload_model()
+	_llama = null
+
+
+func _begin_measure() -> void:
+	_frame_times.clear()
+	_last_ticks = 0
+	_measuring = true
+
+
+func _end_measure(config_name: String, stats: Dictionary) -> void:
+	_measuring = false
+
+	var count = _frame_times.size()
+	var result = {
+		"name": config_name,
+		"tokens_per_second": stats.get("tokens_per_second", 0.0),
+		"n_threads": stats.get("n_threads", 0),
+		"frames": count,
+		"mean_ms": 0.0,
+		"jitter_ms": 0.0,
+		"p99_ms": 0.0,
+		"max_ms": 0.0,
+		"slow_frames": 0,
+	}
+
+	if count > 0:
+		var sorted = _frame_times.duplicate()
+		sorted.sort()
+
+		var sum := 0.0
+		for t in _frame_times:
+			sum += t
+		var mean = sum / count
+
+		var variance := 0.0
+		for t in _frame_times:
+			variance += (t - mean) * (t - mean)
+
+		# Frames que pierden al menos medio frame respecto al objetivo
+		var slow_threshold = 1000.0 / target_fps * 1.5
+		var slow = 0
+		for t in _frame_times:
+			if t > slow_threshold:
+				slow += 1
+
+		result["mean_ms"] = mean
+		result["jitter_ms"] = sqrt(variance / count)
+		result["p99_ms"] = sorted[mini(int(count * 0.99), count - 1)]
+		result["max_ms"] = sorted[count - 1]
+		result["slow_frames"] = slow
+
+	_results.append(result)
+	print("  ✓ %s" % config_name)
+
+
+func _print_results() -> void:
+	print("\n" + "-".repeat(96))
+	print("  %-26s %8s %6s %9s %10s %8s %8s %8s" % [
+		"Configuración", "tok/s", "hilos", "media ms", "jitter ms", "p99 ms", "máx ms", "lentos"])
+	print("-".repeat(96))
+	for r in _results:
+		print("  %-26s %8.1f %6d %9.2f %10.2f %8.2f %8.2f %7.1f%%" % [
+			r["name"], r["tokens_per_second"], r["n_threads"], r["mean_ms"], r["jitter_ms"],
+			r["p99_ms"], r["max_ms"], 100.0 * r["slow_frames"] / maxi(r["frames"], 1)])
+	print("-".repeat(96))
+	print("  jitter = desviación estándar del frame time; lentos = frames > 1.5x el objetivo\n")
+
+
+func _simulate_game_work(ms: float) -> void:
+	var end = Time.get_ticks_usec() + int(ms * 1000.0)
+	while Time.get_ticks_usec() < end:
+		pass
+
+
+func _find_model() -> String:
+	var dir = DirAccess.open("res://models/")
+	if dir == null:
+		return ""
+
+	for file_name in dir.get_files():
+		if file_name.ends_with(".gguf"):
+			return "res://models/" + file_name
+	return ""
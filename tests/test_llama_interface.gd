@@ -55,12 +55,25 @@ func run_all_tests() -> void:
 	# Tests de stop sequences
 	test_stop_sequences()
 
+	# Tests de chunk pipeline (streaming por oraciones)
+	test_chunk_pipeline_defaults()
+	test_chunk_pipeline_sentences()
+	test_chunk_pipeline_utf8_split()
+	test_chunk_pipeline_clause_mode()
+	test_chunk_pipeline_min_length()
+	test_chunk_pipeline_dispatch_limit()
+
+	# Tests de threading
+	test_threading_defaults()
+
 	# Tests de modelo (sin modelo cargado)
 	test_no_model_loaded_state()
 	test_generate_without_model()
 
 	# Tests con modelo (si está disponible)
 	test_with_model_if_available()
+	test_kv_cache_options_if_available()
+	test_thread_isolation_if_available()
 
 
 # ==================== Helpers ====================
@@ -111,6 +124,31 @@ func _assert_approx(actual: float, expected: float, epsilon: float = 0.001, msg:
 	return false
 
 
+func _find_test_model() -> String:
+	# Buscar modelo en res://models/
+	var models_dir = "res://models/"
+	var dir = DirAccess.open(models_dir)
+
+	if dir == null:
+		print("    ⊘ SKIPPED: Directorio models/ no encontrado")
+		return ""
+
+	var model_path: String = ""
+	dir.list_dir_begin()
+	var file_name = dir.get_next()
+	while file_name != "":
+		if file_name.ends_with(".gguf"):
+			model_path = models_dir + file_name
+			break
+		file_name = dir.get_next()
+	dir.list_dir_end()
+
+	if model_path.is_empty():
+		print("    ⊘ SKIPPED: No hay modelos .gguf disponibles")
+
+	return model_path
+
+
 # ==================== Tests de Instanciación ====================
 
 func test_can_instantiate() -> void:
@@ -323,6 +361,212 @@ func test_stop_sequences() -> void:
 	_pass()
 
 
+# ==================== Tests de Chunk Pipeline ====================
+
+func test_chunk_pipeline_defaults() -> void:
+	_start_test("Chunk pipeline: valores por defecto")
+	var pipeline = TextChunkPipeline.new()
+
+	if not _assert_eq(pipeline.split_mode, TextChunkPipeline.SPLIT_SENTENCE):
+		return
+	if not _assert_eq(pipeline.min_chunk_length, 8):
+		return
+	if not _assert_false(pipeline.dispatch_immediately):
+		return
+	if not _assert_eq(pipeline.get_pending_count(), 0):
+		return
+
+	var llama = LlamaInterface.new()
+	if not _assert_true(llama.get_chunk_pipeline() == null, "Sin pipeline al inicio"):
+		return
+	llama.set_chunk_pipeline(pipeline)
+	if not _assert_true(llama.get_chunk_pipeline() == pipeline, "Pipeline asignado"):
+		return
+	llama.set_chunk_pipeline(null)
+	if not _assert_true(llama.get_chunk_pipeline() == null, "Pipeline removido"):
+		return
+
+	_pass()
+
+
+func test_chunk_pipeline_sentences() -> void:
+	_start_test("Chunk pipeline: oraciones a TTS simulado")
+	var pipeline = TextChunkPipeline.new()
+
+	# TTS simulado: registra cada oración que "habla"
+	var spoken: Array = []
+	var tts = func(text: String, index: int): spoken.append([index, text])
+	pipeline.add_consumer(tts)
+	pipeline.add_consumer(tts)  # Duplicado se ignora
+	if not _assert_eq(pipeline.get_consumer_count(), 1, "Consumer duplicado no se agrega"):
+		return
+
+	var finished: Array = []
+	pipeline.stream_finished.connect(func(count: int): finished.append(count))
+
+	pipeline.begin_stream()
+	pipeline.feed("Hola, viajero. ¿Buscas trabajo?  Tengo una misión")
+	if not _assert_eq(pipeline.get_pending_count(), 2, "Dos oraciones completas"):
+		return
+	pipeline.dispatch()
+	if not _assert_eq(spoken.size(), 2):
+		return
+
+	# La última oración sólo sale al cerrar el stream
+	pipeline.feed(" para ti.")
+	pipeline.end_stream()
+	pipeline.dispatch()
+
+	var expected = [
+		[0, "Hola, viajero."],
+		[1, "¿Buscas trabajo?"],
+		[2, "Tengo una misión para ti."],
+	]
+	if not _assert_eq(spoken, expected):
+		return
+	if not _assert_eq(finished, [3], "stream_finished con 3 chunks"):
+		return
+
+	_pass()
+
+
+func test_chunk_pipeline_utf8_split() -> void:
+	_start_test("Chunk pipeline: UTF-8 partido entre tokens")
+	var pipeline = TextChunkPipeline.new()
+	var chunks: Array = []
+	pipeline.add_consumer(func(text: String, _index: int): chunks.append(text))
+
+	# Alimentar byte a byte: "ñ", "ú", "«" y "。" quedan partidos
+	var bytes = "Él dijo: «ñandú». Después se fue.私は行きます。終わり".to_utf8_buffer()
+	pipeline.begin_stream()
+	for i in bytes.size():
+		pipeline.feed_utf8(bytes.slice(i, i + 1))
+	pipeline.end_stream()
+	pipeline.dispatch()
+
+	var expected = ["Él dijo: «ñandú».", "Después se fue.私は行きます。", "終わり"]
+	if not _assert_eq(chunks, expected):
+		return
+
+	_pass()
+
+
+func test_chunk_pipeline_clause_mode() -> void:
+	_start_test("Chunk pipeline: cláusulas a traductor simulado")
+	var pipeline = TextChunkPipeline.new()
+	pipeline.split_mode = TextChunkPipeline.SPLIT_CLAUSE
+	pipeline.min_chunk_length = 0
+
+	# Traductor simulado: diccionario fijo, como haría un servicio externo
+	var glossary = {
+		"Primero,": "First,",
+		"ve al norte;": "go north;",
+		"luego,": "then,",
+		"habla con el herrero.": "talk to the blacksmith.",
+	}
+	var translated: Array = []
+	var translator = func(text: String, _index: int): translated.append(glossary.get(text, "?"))
+	pipeline.add_consumer(translator)
+
+	pipeline.begin_stream()
+	pipeline.feed("Primero, ve al norte; luego, habla con el herrero.")
+	pipeline.end_stream()
+	var delivered = pipeline.dispatch()
+
+	if not _assert_eq(delivered, 4, "4 cláusulas entregadas"):
+		return
+	if not _assert_eq(" ".join(translated), "First, go north; then, talk to the blacksmith."):
+		return
+
+	# Sin consumers los chunks se descartan al despachar
+	pipeline.remove_consumer(translator)
+	pipeline.feed("Otra cosa, más tarde.")
+	pipeline.end_stream()
+	pipeline.dispatch()
+	if not _assert_eq(translated.size(), 4, "Consumer removido no recibe chunks"):
+		return
+
+	_pass()
+
+
+func test_chunk_pipeline_min_length() -> void:
+	_start_test("Chunk pipeline: longitud mínima y números")
+	var pipeline = TextChunkPipeline.new()
+	var chunks: Array = []
+	pipeline.add_consumer(func(text: String, _index: int): chunks.append(text))
+
+	# "Sí." es muy corto y "3.5" no es fin de oración
+	pipeline.begin_stream()
+	pipeline.feed("Sí. Cuesta 3.5 monedas de oro. ¡Gracias!\nAdiós")
+	pipeline.end_stream()
+	pipeline.dispatch()
+
+	var expected = ["Sí. Cuesta 3.5 monedas de oro.", "¡Gracias!", "Adiós"]
+	if not _assert_eq(chunks, expected):
+		return
+
+	_pass()
+
+
+func test_chunk_pipeline_dispatch_limit() -> void:
+	_start_test("Chunk pipeline: dispatch limitado y cola llena")
+	var pipeline = TextChunkPipeline.new()
+	var indices: Array = []
+	pipeline.add_consumer(func(_text: String, index: int): indices.append(index))
+
+	# Más oraciones que la capacidad de la cola: el orden debe mantenerse
+	var count = 600
+	pipeline.begin_stream()
+	for i in count:
+		pipeline.feed("Oración número %d. " % i)
+	pipeline.end_stream()
+
+	if not _assert_eq(pipeline.dispatch(10), 10, "dispatch(10) entrega 10"):
+		return
+	if not _assert_eq(pipeline.dispatch(), count - 10):
+		return
+	if not _assert_eq(pipeline.get_pending_count(), 0):
+		return
+
+	var expected = range(count)
+	if not _assert_eq(indices, expected, "Índices en orden"):
+		return
+
+	_pass()
+
+
+# ==================== Tests de Threading ====================
+
+func test_threading_defaults() -> void:
+	_start_test("Threading: valores por defecto y límites")
+	var llama = LlamaInterface.new()
+
+	if not _assert_false(llama.adaptive_threads):
+		return
+	if not _assert_approx(llama.frame_budget_ms, 20.0):
+		return
+	if not _assert_eq(llama.min_threads, 1):
+		return
+	if not _assert_eq(llama.get_active_threads(), 0, "Sin modelo no hay hilos activos"):
+		return
+	if not _assert_true(llama.get_generation_stats().is_empty(), "Sin estadísticas antes de generar"):
+		return
+
+	# Límites
+	llama.frame_budget_ms = 0.0
+	if not _assert_approx(llama.frame_budget_ms, 1.0, 0.001, "Budget mínimo 1ms"):
+		return
+	llama.min_threads = 0
+	if not _assert_eq(llama.min_threads, 1, "Mínimo 1 hilo"):
+		return
+
+	# Reportar frames sin modelo no debe fallar
+	llama.report_frame_time(50.0)
+	llama.report_frame_time(5.0)
+
+	_pass()
+
+
 # ==================== Tests de Modelo ====================
 
 func test_no_model_loaded_state() -> void:
@@ -350,26 +594,8 @@ func test_generate_without_model() -> void:
 func test_with_model_if_available() -> void:
 	_start_test("Test con modelo (si está disponible)")
 
-	# Buscar modelo en res://models/
-	var models_dir = "res://models/"
-	var dir = DirAccess.open(models_dir)
-
-	if dir == null:
-		print("    ⊘ SKIPPED: Directorio models/ no encontrado")
-		return
-
-	var model_path: String = ""
-	dir.list_dir_begin()
-	var file_name = dir.get_next()
-	while file_name != "":
-		if file_name.ends_with(".gguf"):
-			model_path = models_dir + file_name
-			break
-		file_name = dir.get_next()
-	dir.list_dir_end()
-
+	var model_path = _find_test_model()
 	if model_path.is_empty():
-		print("    ⊘ SKIPPED: No hay modelos .gguf disponibles")
 		return
 
 	print("    Usando modelo: %s" % model_path)
@@ -402,6 +628,19 @@ func test_with_model_if_available() -> void:
 
 	print("    Generado: '%s'" % result.substr(0, 50))
 
+	# Test streaming: los chunks reconstruyen el texto generado
+	var pipeline = TextChunkPipeline.new()
+	var streamed: Array = []
+	pipeline.add_consumer(func(text: String, _index: int): streamed.append(text))
+	llama.set_chunk_pipeline(pipeline)
+	var result_streamed = llama.generate("The capital of France is")
+	pipeline.dispatch()
+	llama.set_chunk_pipeline(null)
+	if not _assert_eq("".join(streamed).replace(" ", "").replace("\n", ""),
+			result_streamed.replace(" ", "").replace("\n", ""), "Chunks deben coincidir con el texto"):
+		llama.unload_model()
+		return
+
 	# Test timeout (con timeout muy corto)
 	llama.set_timeout(1)  # 1ms - debería hacer timeout
 	llama.set_max_tokens(1000)
@@ -419,3 +658,121 @@ func test_with_model_if_available() -> void:
 		return
 
 	_pass("Todos los tests con modelo pasaron")
+
+
+func test_kv_cache_options_if_available() -> void:
+	_start_test("KV cache cuantizado y memory budget (si hay modelo)")
+
+	var model_path = _find_test_model()
+	if model_path.is_empty():
+		return
+
+	var llama = LlamaInterface.new()
+
+	# Tipo de cache inválido debe fallar antes de cargar el modelo
+	var err = llama.load_model(model_path, {"type_k": "q3_k"})
+	if not _assert_eq(err, ERR_INVALID_PARAMETER, "type_k inválido debe ser rechazado"):
+		return
+
+	# Cache K/V en q8_0 con flash attention
+	err = llama.load_model(model_path, {
+		"n_ctx": 512,
+		"type_k": "q8_0",
+		"type_v": "q8_0",
+		"flash_attn": true
+	})
+	if err != OK:
+		print("    ⊘ SKIPPED: Error cargando modelo con cache q8_0 (%d)" % err)
+		return
+
+	var info = llama.get_model_info()
+	if not _assert_eq(info.get("type_k"), "q8_0"):
+		llama.unload_model()
+		return
+	if not _assert_eq(info.get("type_v"), "q8_0"):
+		llama.unload_model()
+		return
+	llama.unload_model()
+
+	# Memory budget: una sola secuencia, n_ctx como máximo
+	var model_file = FileAccess.open(model_path, FileAccess.READ)
+	var budget_mb = int(model_file.get_length() / (1024 * 1024)) + 512
+	model_file.close()
+	err = llama.load_model(model_path, {"memory_budget_mb": budget_mb, "n_ctx": 512, "type_k": "q8_0", "type_v": "q8_0"})
+	if not _assert_eq(err, OK, "Budget de %d MB debe alcanzar para 512 tokens" % budget_mb):
+		return
+
+	info = llama.get_model_info()
+	llama.unload_model()
+	if not _assert_eq(info.get("n_ctx", 0), 512, "n_ctx pedido debe respetarse como máximo"):
+		return
+
+	_pass("512 tokens en %d MB" % budget_mb)
+
+
+func test_thread_isolation_if_available() -> void:
+	_start_test("Aislamiento de hilos y modo adaptativo (si hay modelo)")
+
+	var model_path = _find_test_model()
+	if model_path.is_empty():
+		return
+
+	var cpus = OS.get_processor_count()
+	if cpus < 2:
+		print("    ⊘ SKIPPED: Se necesitan al menos 2 CPUs")
+		return
+
+	var llama = LlamaInterface.new()
+
+	# CPU fuera de rango debe fallar antes de cargar el modelo
+	var err = llama.load_model(model_path, {"cpu_affinity": PackedInt32Array([cpus])})
+	if not _assert_eq(err, ERR_INVALID_PARAMETER, "cpu_affinity inválido debe ser rechazado"):
+		return
+
+	# Reservar un core para el motor
+	var params = {"n_ctx": 512, "reserved_cores": 1, "thread_nice": 5}
+	if OS.get_name() == "Linux":
+		params["pin_threads"] = true
+	err = llama.load_model(model_path, params)
+	if err != OK:
+		print("    ⊘ SKIPPED: Error cargando modelo (%d)" % err)
+		return
+
+	# Con cpuset o contenedores el proceso puede tener menos CPUs que get_processor_count()
+	var info = llama.get_model_info()
+	var n_threads: int = info.get("n_threads", 0)
+	if not _assert_true(n_threads >= 1 and n_threads <= cpus - 1, "n_threads usa solo los cores no reservados (%d)" % n_threads):
+		llama.unload_model()
+		return
+	if OS.get_name() == "Linux":
+		var affinity = Array(info.get("cpu_affinity"))
+		if not _assert_eq(affinity.size(), n_threads, "Un core fijado por hilo"):
+			llama.unload_model()
+			return
+		var sorted = affinity.duplicate()
+		sorted.sort()
+		if not _assert_true(affinity == sorted and affinity.back() < cpus, "Fijado a los cores permitidos más altos"):
+			llama.unload_model()
+			return
+
+	# Modo adaptativo: reportar overruns continuos desde el hilo principal
+	llama.adaptive_threads = true
+	llama.max_tokens = 32
+	llama.temperature = 0.0
+	var thread = Thread.new()
+	thread.start(llama.generate.bind("Once upon a time"))
+	while thread.is_alive():
+		llama.report_frame_time(100.0)
+		OS.delay_msec(1)
+	thread.wait_to_finish()
+
+	var stats = llama.get_generation_stats()
+	llama.unload_model()
+
+	if not _assert_true(stats.get("generated_tokens", 0) > 0, "Debería generar tokens"):
+		return
+	if stats.get("generated_tokens", 0) > 2 and cpus > 2:
+		if not _assert_true(stats.get("n_threads", cpus) < cpus - 1, "Overruns deben reducir los hilos"):
+			return
+
+	_pass("%.1f tok/s con %d hilo(s) al final" % [stats.get("tokens_per_second", 0.0), stats.get("n_threads", 0)])
@@ -0,0 +1,412 @@
+## Tests para ParallelDownloader contra un servidor HTTP local
+## Ejecutar desde editor: Abrir tests/test_downloader_scene.tscn y presionar F6
+## Ejecutar headless: godot --headless --path "." res://tests/test_downloader_scene.tscn
+extends Node
+
+
+## Si true, cierra Godot al terminar (para CI/headless)
+@export var auto_quit: bool = false
+
+const TEST_DIR = "user://test_downloads/"
+const PAYLOAD_SIZE = 3 * 1024 * 1024 + 123  # No múltiplo del segmento a propósito
+const SEGMENT_SIZE = 256 * 1024
+const TIMEOUT_MS = 30000
+
+var _tests_passed: int = 0
+var _tests_failed: int = 0
+var _current_test: String = ""
+
+var _server: LocalHttpServer
+var _payload: PackedByteArray
+var _payload_sha256: String
+
+
+## Servidor HTTP/1.1 mínimo con soporte de Range, atendido desde _process
+class LocalHttpServer:
+	var payload: PackedByteArray
+	var honour_ranges: bool = true
+	var max_bytes_per_poll: int = 0  # 0 = sin límite
+	var bytes_sent: int = 0
+
+	var _tcp := TCPServer.new()
+	var _clients: Array[Dictionary] = []
+
+	func start() -> Error:
+		return _tcp.listen(0, "127.0.0.1")
+
+	func get_url(path: String = "/model.gguf") -> String:
+		return "http://127.0.0.1:%d%s" % [_tcp.get_local_port(), path]
+
+	func stop() -> void:
+		for client in _clients:
+			client.peer.disconnect_from_host()
+		_clients.clear()
+		_tcp.stop()
+
+	func poll() -> void:
+		while _tcp.is_connection_available():
+			_clients.append({"peer": _tcp.take_connection(), "request": "", "out": PackedByteArray()})
+
+		var budget = max_bytes_per_poll
+		for client in _clients.duplicate():
+			var peer: StreamPeerTCP = client.peer
+			peer.poll()
+			if peer.get_status() != StreamPeerTCP.STATUS_CONNECTED:
+				_clients.erase(client)
+				continue
+
+			# Leer la petición
+			var available = peer.get_available_bytes()
+			if available > 0:
+				client.request += peer.get_utf8_string(available)
+			var header_end = client.request.find("\r\n\r\n")
+			if header_end >= 0 and client.out.is_empty():
+				client.out = _build_response(client.request.substr(0, header_end))
+				client.request = client.request.substr(header_end + 4)
+
+			# Enviar respuesta pendiente (limitada si hay throttle)
+			if not client.out.is_empty():
+				var size = client.out.size()
+				if max_bytes_per_poll > 0:
+					size = mini(size, budget)
+				if size <= 0:
+					continue
+				var result = peer.put_partial_data(client.out.slice(0, size))
+				var sent: int = result[1]
+				client.out = client.out.slice(sent)
+				if max_bytes_per_poll > 0:
+					budget -= sent
+
+	func _build_response(request: String) -> PackedByteArray:
+		var start = 0
+		var end = payload.size() - 1
+		var partial = false
+
+		for line in request.split("\r\n"):
+			if honour_ranges and line.to_lower().begins_with("range: bytes="):
+				var range_spec = line.substr(line.find("=") + 1).split("-")
+				start = int(range_spec[0])
+				if range_spec.size() > 1 and not range_spec[1].is_empty():
+					end = mini(int(range_spec[1]), payload.size() - 1)
+				partial = true
+
+		var body = payload.slice(start, end + 1)
+		var head = "HTTP/1.1 206 Partial Content\r\n" if partial else "HTTP/1.1 200 OK\r\n"
+		if partial:
+			head += "Content-Range: bytes %d-%d/%d\r\n" % [start, end, payload.size()]
+		head += "Content-Length: %d\r\n" % body.size()
+		head += "Content-Type: application/octet-stream\r\n\r\n"
+
+		bytes_sent += body.size()
+		var response = head.to_utf8_buffer()
+		response.append_array(body)
+		return response
+
+
+func _ready() -> void:
+	# Detectar si estamos en modo headless
+	if DisplayServer.get_name() == "headless":
+		auto_quit = true
+
+	print("\n" + "=".repeat(60))
+	print("  ParallelDownloader - Tests con servidor local")
+	print("=".repeat(60) + "\n")
+
+	_setup()
+	await run_all_tests()
+	_teardown()
+
+	print("\n" + "=".repeat(60))
+	if _tests_failed == 0:
+		print("  Resultados: %d passed, %d failed" % [_tests_passed, _tests_failed])
+	else:
+		print("  Resultados: %d passed, %d FAILED" % [_tests_passed, _tests_failed])
+	print("=".repeat(60) + "\n")
+
+	if auto_quit:
+		get_tree().quit(0 if _tests_failed == 0 else 1)
+
+
+func _process(_delta: float) -> void:
+	if _server != null:
+		_server.poll()
+
+
+func run_all_tests() -> void:
+	# Tests sin red
+	test_can_instantiate()
+	test_invalid_url()
+
+	# Tests con servidor local
+	await test_parallel_download_with_checksum()
+	await test_checksum_mismatch()
+	await test_resume_after_cancel()
+	await test_server_without_ranges()
+	await test_single_stream_cancel_discards()
+
+
+# ==================== Helpers ====================
+
+func _setup() -> void:
+	DirAccess.make_dir_recursive_absolute(TEST_DIR)
+
+	# Datos deterministas para poder comparar
+	var rng = RandomNumberGenerator.new()
+	rng.seed = 1234
+	_payload = PackedByteArray()
+	_payload.resize(PAYLOAD_SIZE)
+	for i in range(PAYLOAD_SIZE):
+		_payload[i] = rng.randi() & 0xFF
+
+	var ctx = HashingContext.new()
+	ctx.start(HashingContext.HASH_SHA256)
+	ctx.update(_payload)
+	_payload_sha256 = ctx.finish().hex_encode()
+
+	_server = LocalHttpServer.new()
+	_server.payload = _payload
+	var err = _server.start()
+	if err != OK:
+		push_error("No se pudo iniciar el servidor local: %s" % error_string(err))
+
+
+func _teardown() -> void:
+	_server.stop()
+	_server = null
+	for file_name in DirAccess.get_files_at(TEST_DIR):
+		DirAccess.remove_absolute(ProjectSettings.globalize_path(TEST_DIR + file_name))
+
+
+func _reset_server() -> void:
+	_server.honour_ranges = true
+	_server.max_bytes_per_poll = 0
+	_server.bytes_sent = 0
+
+
+func _wait_for(downloader: ParallelDownloader, condition: Callable = Callable()) -> bool:
+	var started = Time.get_ticks_msec()
+	while Time.get_ticks_msec() - started < TIMEOUT_MS:
+		if condition.is_valid():
+			if condition.call():
+				return true
+		elif not downloader.is_running():
+			return true
+		await get_tree().process_frame
+	return false
+
+
+func _start_test(name: String) -> void:
+	_current_test = name
+	print("  [TEST] %s..." % name)
+
+
+func _pass(msg: String = "") -> void:
+	_tests_passed += 1
+	if msg.is_empty():
+		print("    ✓ PASSED")
+	else:
+		print("    ✓ PASSED: %s" % msg)
+
+
+func _fail(msg: String) -> void:
+	_tests_failed += 1
+	print("    ✗ FAILED: %s" % msg)
+
+
+func _assert_eq(actual, expected, msg: String = "") -> bool:
+	if actual == expected:
+		return true
+	_fail("Expected %s but got %s. %s" % [expected, actual, msg])
+	return false
+
+
+func _assert_true(condition: bool, msg: String = "") -> bool:
+	if condition:
+		return true
+	_fail("Expected true. %s" % msg)
+	return false
+
+
+func _assert_false(condition: bool, msg: String = "") -> bool:
+	if not condition:
+		return true
+	_fail("Expected false. %s" % msg)
+	return false
+
+
+# ==================== Tests sin red ====================
+
+func test_can_instantiate() -> void:
+	_start_test("Puede instanciar ParallelDownloader")
+	var downloader = ParallelDownloader.new()
+
+	if not _assert_eq(downloader.get_status(), ParallelDownloader.STATUS_IDLE, "Estado inicial debe ser IDLE"):
+		return
+	if not _assert_false(downloader.is_running()):
+		return
+	if not _assert_eq(downloader.get_sha256(), "", "Sin hash antes de descargar"):
+		return
+
+	_pass()
+
+
+func test_invalid_url() -> void:
+	_start_test("URL inválida es rechazada")
+	var downloader = ParallelDownloader.new()
+
+	var err = downloader.start("ftp://example.com/model.gguf", TEST_DIR + "invalid.gguf")
+	if not _assert_eq(err, ERR_INVALID_PARAMETER):
+		return
+	if not _assert_false(downloader.is_running()):
+		return
+
+	_pass()
+
+
+# ==================== Tests con servidor local ====================
+
+func test_parallel_download_with_checksum() -> void:
+	_start_test("Descarga paralela con checksum")
+	_reset_server()
+	var path = TEST_DIR + "parallel.gguf"
+	var downloader = ParallelDownloader.new()
+
+	var err = downloader.start(_server.get_url(), path, {
+		"connections": 4,
+		"segment_size": SEGMENT_SIZE,
+		"sha256": _payload_sha256
+	})
+	if not _assert_eq(err, OK):
+		return
+	if not _assert_true(await _wait_for(downloader), "Timeout esperando la descarga"):
+		downloader.cancel()
+		return
+
+	if not _assert_eq(downloader.get_status(), ParallelDownloader.STATUS_COMPLETED, downloader.get_error_message()):
+		return
+	if not _assert_eq(downloader.get_sha256(), _payload_sha256):
+		return
+	if not _assert_eq(downloader.get_downloaded_bytes(), PAYLOAD_SIZE):
+		return
+	if not _assert_true(FileAccess.get_file_as_bytes(path) == _payload, "Contenido distinto al original"):
+		return
+	if not _assert_false(FileAccess.file_exists(path + ".progress"), "El archivo de progreso debe borrarse"):
+		return
+	if not _assert_false(FileAccess.file_exists(path + ".part"), "El archivo .part debe renombrarse"):
+		return
+
+	_pass()
+
+
+func test_checksum_mismatch() -> void:
+	_start_test("Checksum incorrecto falla y borra el archivo")
+	_reset_server()
+	var path = TEST_DIR + "corrupt.gguf"
+	var downloader = ParallelDownloader.new()
+
+	downloader.start(_server.get_url(), path, {
+		"segment_size": SEGMENT_SIZE,
+		"sha256": "0".repeat(64)
+	})
+	if not _assert_true(await _wait_for(downloader), "Timeout esperando la descarga"):
+		downloader.cancel()
+		return
+
+	if not _assert_eq(downloader.get_status(), ParallelDownloader.STATUS_FAILED):
+		return
+	if not _assert_eq(downloader.get_error(), ERR_FILE_CORRUPT):
+		return
+	if not _assert_false(FileAccess.file_exists(path), "Archivo corrupto no debe aparecer como descargado"):
+		return
+	if not _assert_false(FileAccess.file_exists(path + ".part"), "Archivo corrupto debe borrarse"):
+		return
+	if not _assert_false(FileAccess.file_exists(path + ".progress"), "El progreso corrupto debe borrarse"):
+		return
+
+	_pass()
+
+
+func test_resume_after_cancel() -> void:
+	_start_test("Reanudar descarga después de cancelar")
+	_reset_server()
+	_server.max_bytes_per_poll = 64 * 1024  # Lento para poder cancelar a mitad
+	var path = TEST_DIR + "resume.gguf"
+	var downloader = ParallelDownloader.new()
+	var options = {"connections": 2, "segment_size": SEGMENT_SIZE, "sha256": _payload_sha256}
+
+	downloader.start(_server.get_url(), path, options)
+	var halfway = func(): return downloader.get_downloaded_bytes() >= PAYLOAD_SIZE / 2
+	if not _assert_true(await _wait_for(downloader, halfway), "No llegó a la mitad"):
+		downloader.cancel()
+		return
+
+	downloader.cancel()
+	if not _assert_eq(downloader.get_status(), ParallelDownloader.STATUS_CANCELLED):
+		return
+	if not _assert_true(FileAccess.file_exists(path + ".progress"), "Debe quedar el progreso guardado"):
+		return
+	if not _assert_true(FileAccess.file_exists(path + ".part"), "Debe quedar el archivo parcial"):
+		return
+	if not _assert_false(FileAccess.file_exists(path), "El archivo incompleto no debe usar el nombre final"):
+		return
+
+	# Segunda sesión: solo debe pedir los segmentos que faltan
+	_reset_server()
+	downloader.start(_server.get_url(), path, options)
+	if not _assert_true(await _wait_for(downloader), "Timeout reanudando"):
+		downloader.cancel()
+		return
+
+	if not _assert_eq(downloader.get_status(), ParallelDownloader.STATUS_COMPLETED, downloader.get_error_message()):
+		return
+	if not _assert_eq(downloader.get_sha256(), _payload_sha256, "Hash debe continuar el de la sesión anterior"):
+		return
+	if not _assert_true(_server.bytes_sent < PAYLOAD_SIZE, "Reenvió %d bytes, debería ser menos que el total" % _server.bytes_sent):
+		return
+
+	_pass("Reanudado enviando %d de %d bytes" % [_server.bytes_sent, PAYLOAD_SIZE])
+
+
+func test_server_without_ranges() -> void:
+	_start_test("Servidor sin soporte de Range usa una conexión")
+	_reset_server()
+	_server.honour_ranges = false
+	var path = TEST_DIR + "single.gguf"
+	var downloader = ParallelDownloader.new()
+
+	downloader.start(_server.get_url(), path, {"connections": 4, "sha256": _payload_sha256})
+	if not _assert_true(await _wait_for(downloader), "Timeout esperando la descarga"):
+		downloader.cancel()
+		return
+
+	if not _assert_eq(downloader.get_status(), ParallelDownloader.STATUS_COMPLETED, downloader.get_error_message()):
+		return
+	if not _assert_true(FileAccess.get_file_as_bytes(path) == _payload, "Contenido distinto al original"):
+		return
+
+	_pass()
+
+
+func test_single_stream_cancel_discards() -> void:
+	_start_test("Cancelar sin soporte de Range borra el parcial")
+	_reset_server()
+	_server.honour_ranges = false
+	_server.max_bytes_per_poll = 64 * 1024  # Lento para poder cancelar a mitad
+	var path = TEST_DIR + "single_cancel.gguf"
+	var downloader = ParallelDownloader.new()
+
+	downloader.start(_server.get_url(), path, {"sha256": _payload_sha256})
+	var started = func(): return downloader.get_downloaded_bytes() > 0
+	if not _assert_true(await _wait_for(downloader, started), "No empezó a descargar"):
+		downloader.cancel()
+		return
+
+	downloader.cancel()
+	if not _assert_eq(downloader.get_status(), ParallelDownloader.STATUS_CANCELLED):
+		return
+	# Una sola conexión no se puede reanudar: no debe quedar nada en disco
+	for leftover in [path, path + ".part", path + ".progress"]:
+		if not _assert_false(FileAccess.file_exists(leftover), "Quedó %s" % leftover):
+			return
+
+	_pass()